@@ -0,0 +1,177 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "http/inputSlicer.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+using namespace dci::module::www;
+using namespace dci::module::www::http;
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// request slicer without api, counts what would be emitted
+class Decoder
+    : protected InputSlicer<inputSlicer::Mode::request, Decoder>
+{
+    using IS = InputSlicer<inputSlicer::Mode::request, Decoder>;
+
+public:
+    bool feed(Bytes& data)
+    {
+        bytes::Alter alter = data.begin();
+        while(!alter.atEnd())
+        {
+            inputSlicer::Result result;
+            {
+                inputSlicer::SourceAdapter sa{alter};
+                result = IS::process(sa);
+            }
+
+            switch(result)
+            {
+            case inputSlicer::Result::needMore:
+                break;
+
+            case inputSlicer::Result::done:
+                ++_messages;
+                reset();
+                break;
+
+            default:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::size_t _messages{};
+    std::size_t _bodySize{};
+    bool _emitDataDoneOnClose{};
+
+private:
+    friend IS;
+
+    inputSlicer::Result sliceFlush(inputSlicer::state::RequestFirstLine& firstLine)
+    {
+        return IS::sliceFlush(firstLine);
+    }
+
+    inputSlicer::Result sliceFlush(inputSlicer::state::Headers& headers, bool done)
+    {
+        headers._conveyor.detachSome();
+        return IS::sliceFlush(headers, done);
+    }
+
+    inputSlicer::Result sliceFlush(inputSlicer::state::Body& body, bool done)
+    {
+        _bodySize += body._content.size();
+        body._content.clear();
+        return IS::sliceFlush(body, done);
+    }
+};
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+std::string message(std::size_t chunkSize, std::size_t bodySize)
+{
+    std::string res = "POST /upload HTTP/1.1\r\nHost: bench\r\nTransfer-Encoding: chunked\r\n\r\n";
+
+    char length[16];
+    std::snprintf(length, sizeof(length), "%zx\r\n", chunkSize);
+
+    std::string chunk(chunkSize, 'x');
+    for(std::size_t i{}; i<chunkSize; ++i)
+        chunk[i] = static_cast<char>('a' + i % 26);
+
+    for(std::size_t size{}; size < bodySize; size += chunkSize)
+    {
+        res += length;
+        res += chunk;
+        res += "\r\n";
+    }
+
+    res += "0\r\n\r\n";
+    return res;
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// cycles per body byte, traffic delivered by portions of the given size
+double measure(std::size_t chunkSize, std::size_t portionSize)
+{
+    static constexpr std::size_t bodySize = 1u << 20;
+    std::string traffic = message(chunkSize, bodySize);
+
+    std::vector<std::string_view> portions;
+    for(std::size_t offset{}; offset < traffic.size(); offset += portionSize)
+        portions.emplace_back(std::string_view{traffic}.substr(offset, portionSize));
+
+    static constexpr std::size_t rounds = 32;
+    Decoder decoder;
+    std::uint64_t spent{};
+
+    for(std::size_t i{}; i<rounds; ++i)
+    {
+        std::vector<Bytes> input;
+        input.reserve(portions.size());
+        for(std::string_view portion : portions)
+            input.emplace_back().end().write(portion.data(), portion.size());
+
+        std::uint64_t start = ticks();
+        for(Bytes& portion : input)
+        {
+            if(!decoder.feed(portion))
+            {
+                std::cerr << "decoding failed" << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        spent += ticks() - start;
+    }
+
+    if(rounds != decoder._messages || rounds * ((bodySize + chunkSize - 1) / chunkSize) * chunkSize != decoder._bodySize)
+    {
+        std::cerr << "decoded body mismatch" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    return static_cast<double>(spent) / static_cast<double>(decoder._bodySize);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+int main()
+{
+    std::cout << "chunked body decoding, units: cycles/body byte (rdtsc)" << std::endl;
+    std::cout << std::setw(8) << "chunk" << std::setw(12) << "whole" << std::setw(12) << "by 1460" << std::endl;
+
+    for(std::size_t chunkSize : {64, 1024, 16384})
+    {
+        std::cout
+            << std::setw(8) << chunkSize
+            << std::setw(12) << std::fixed << std::setprecision(3) << measure(chunkSize, ~std::size_t{})
+            << std::setw(12) << std::fixed << std::setprecision(3) << measure(chunkSize, 1460)
+            << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
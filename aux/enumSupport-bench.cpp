@@ -0,0 +1,135 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "enumSupport.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+using namespace dci::module::www;
+using KeyRecognized = api::http::header::KeyRecognized;
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// typical browser request header set
+const std::vector<std::string> p_canonical
+{
+    "Host", "User-Agent", "Accept", "Accept-Language", "Accept-Encoding", "Referer", "Connection", "Cookie",
+    "Upgrade-Insecure-Requests", "Sec-Fetch-Dest", "Sec-Fetch-Mode", "Sec-Fetch-Site", "Sec-Fetch-User",
+    "Cache-Control", "Content-Type", "Content-Length", "X-Forwarded-For", "X-Request-ID", "If-None-Match", "Authorization",
+};
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+const std::vector<std::string> p_unknown
+{
+    "X-Amzn-Trace-Id", "X-Custom", "Sec-CH-UA-Platform-Version", "X-B3-TraceId", "Foo", "Priority-Hint", "X-Envoy-Expected-Rq-Timeout-Ms",
+};
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+std::vector<std::string> lowered(std::vector<std::string> names)
+{
+    for(std::string& name : names)
+        for(char& c : name)
+            if('A' <= c && c <= 'Z')
+                c = c - 'A' + 'a';
+    return names;
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// ticks per lookup
+double measure(auto recognizer, const std::vector<std::string>& names)
+{
+    std::vector<std::string_view> views{names.begin(), names.end()};
+    std::size_t rounds = (8u << 20) / views.size();
+    std::size_t sink{};
+
+    std::uint64_t start = ticks();
+    for(std::size_t i{}; i<rounds; ++i)
+    {
+        for(std::string_view name : views)
+        {
+            std::optional<KeyRecognized> key = recognizer(name);
+            sink += key ? static_cast<std::size_t>(*key) : 1;
+            asm volatile("" : : "r"(sink) : "memory");
+        }
+    }
+    std::uint64_t stop = ticks();
+
+    return static_cast<double>(stop - start) / static_cast<double>(rounds * views.size());
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+int main()
+{
+    auto trie = [](std::string_view s){return enumSupport::toEnum<KeyRecognized>(s);};
+    auto hash = [](std::string_view s){return enumSupport::toEnumPh<KeyRecognized>(s);};
+
+    for(const std::string& name : p_canonical)
+    {
+        if(trie(name) != hash(name) || trie(name) != hash(lowered({name})[0]))
+        {
+            std::cerr << "recognizers disagree on " << name << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "header name recognition, units: cycles/lookup (rdtsc)" << std::endl;
+    std::cout << std::setw(12) << "set" << std::setw(10) << "trie" << std::setw(10) << "hash" << std::setw(10) << "ratio" << std::endl;
+
+    auto row = [&](const char* title, const std::vector<std::string>& names)
+    {
+        double t = measure(trie, names);
+        double h = measure(hash, names);
+        std::cout
+            << std::setw(12) << title
+            << std::setw(10) << std::fixed << std::setprecision(2) << t
+            << std::setw(10) << std::fixed << std::setprecision(2) << h
+            << std::setw(10) << std::fixed << std::setprecision(2) << t / h
+            << std::endl;
+    };
+
+    row("canonical", p_canonical);
+    row("lowercase", lowered(p_canonical));
+    row("unknown", p_unknown);
+
+    // same names in an unpredictable order, as traffic from many clients looks
+    {
+        std::vector<std::string> mixed;
+        std::vector<std::string> lowercase = lowered(p_canonical);
+        std::uint32_t rnd = 1;
+        for(std::size_t i{}; i<4096; ++i)
+        {
+            rnd = rnd * 1664525u + 1013904223u;
+            std::size_t idx = rnd >> 8;
+            switch(idx % 4)
+            {
+            case 0:
+            case 1:     mixed.push_back(p_canonical[idx / 4 % p_canonical.size()]); break;
+            case 2:     mixed.push_back(lowercase[idx / 4 % lowercase.size()]); break;
+            default:    mixed.push_back(p_unknown[idx / 4 % p_unknown.size()]); break;
+            }
+        }
+        row("mixed", mixed);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <iomanip>
 #include <regex>
+#include <numeric>
 #include <dci/utils/integer.hpp>
 
 using namespace dci::idl;
@@ -370,6 +371,139 @@ struct Trie
     }
 };
 
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// hash-and-displace minimal perfect hash, see ph:: in enumSupport.hpp for the runtime part
+template <bool lowerCase>
+struct PerfectHash
+{
+    struct Item
+    {
+        std::string     key;
+        std::string     value;
+        std::uint64_t   hash{};
+    };
+
+    std::uint32_t               bucketsCount{};
+    std::vector<std::uint16_t>  displacements;
+    std::vector<Item>           slots;
+    std::size_t                 minSize{~std::size_t{}};
+    std::size_t                 maxSize{};
+
+    void push(std::string_view key, std::string value)
+    {
+        std::string folded{key};
+        if(lowerCase)
+            for(char& c : folded)
+                if('A' <= c && c <= 'Z')
+                    c = c - 'A' + 'a';
+
+        std::uint64_t hash = ph::hash<false>(folded.data(), folded.size());
+        minSize = std::min(minSize, folded.size());
+        maxSize = std::max(maxSize, folded.size());
+        items.push_back(Item{std::move(folded), std::move(value), hash});
+    }
+
+    void build()
+    {
+        std::set<std::uint64_t> hashes;
+        for(const Item& item : items)
+            if(!hashes.emplace(item.hash).second)
+                throw std::runtime_error{"perfect hash: full hash collision on " + item.key};
+
+        for(bucketsCount = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(items.size()/4)); bucketsCount <= items.size(); ++bucketsCount)
+            if(tryBuild())
+                return;
+
+        throw std::runtime_error{"perfect hash: unable to displace"};
+    }
+
+    void generateCpp(std::size_t indent, const std::string& nameStr) const
+    {
+        std::cout << prf(indent) << "static constexpr std::uint32_t bucketsCount = " << bucketsCount << ";\n";
+        std::cout << prf(indent) << "static constexpr std::uint32_t slotsCount = " << slots.size() << ";\n";
+        std::cout << prf(indent) << "static constexpr std::uint16_t displacements[bucketsCount] =\n";
+        std::cout << prf(indent) << "{";
+        for(std::size_t i{}; i<displacements.size(); ++i)
+            std::cout << (i % 16 ? " " : "\n" + prf(indent+1)) << displacements[i] << ",";
+        std::cout << "\n" << prf(indent) << "};\n";
+        std::cout << prf(indent) << "static constexpr struct {std::string_view _key; " << nameStr << " _value;} slots[slotsCount] =\n";
+        std::cout << prf(indent) << "{\n";
+        for(const Item& item : slots)
+            std::cout << prf(indent+1) << "{" << escapedString(item.key) << "sv, " << item.value << "},\n";
+        std::cout << prf(indent) << "};\n";
+        std::cout << "\n";
+        std::cout << prf(indent) << "if(s.size() < " << minSize << " || s.size() > " << maxSize << ")\n";
+        std::cout << prf(indent+1) << "return {};\n";
+        std::cout << "\n";
+        std::cout << prf(indent) << "std::uint64_t h = ph::hash<" << (lowerCase ? "true" : "false") << ">(s.data(), s.size());\n";
+        std::cout << prf(indent) << "const auto& slot = slots[ph::slot(h, displacements[ph::bucket(h, bucketsCount)], slotsCount)];\n";
+        std::cout << prf(indent) << "if(!ph::equal<" << (lowerCase ? "true" : "false") << ">(s, slot._key))\n";
+        std::cout << prf(indent+1) << "return {};\n";
+        std::cout << "\n";
+        std::cout << prf(indent) << "return slot._value;\n";
+    }
+
+private:
+    bool tryBuild()
+    {
+        std::vector<std::vector<const Item*>> buckets(bucketsCount);
+        for(const Item& item : items)
+            buckets[ph::bucket(item.hash, bucketsCount)].push_back(&item);
+
+        std::vector<std::uint32_t> order(bucketsCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b){return buckets[a].size() > buckets[b].size();});
+
+        std::uint32_t slotsCount = static_cast<std::uint32_t>(items.size());
+        std::vector<const Item*> taken(slotsCount);
+        displacements.assign(bucketsCount, 0);
+
+        for(std::uint32_t bucketIdx : order)
+        {
+            const std::vector<const Item*>& bucket = buckets[bucketIdx];
+            if(bucket.empty())
+                break;
+
+            bool placed = false;
+            std::vector<std::uint32_t> bucketSlots;
+            for(std::uint32_t displacement{}; displacement <= 0xffff && !placed; ++displacement)
+            {
+                bucketSlots.clear();
+                placed = true;
+                for(const Item* item : bucket)
+                {
+                    std::uint32_t slot = ph::slot(item->hash, static_cast<std::uint16_t>(displacement), slotsCount);
+                    if(taken[slot] || bucketSlots.end() != std::find(bucketSlots.begin(), bucketSlots.end(), slot))
+                    {
+                        placed = false;
+                        break;
+                    }
+                    bucketSlots.push_back(slot);
+                }
+
+                if(placed)
+                {
+                    displacements[bucketIdx] = static_cast<std::uint16_t>(displacement);
+                    for(std::size_t i{}; i<bucket.size(); ++i)
+                        taken[bucketSlots[i]] = bucket[i];
+                }
+            }
+
+            if(!placed)
+                return false;
+        }
+
+        slots.clear();
+        for(const Item* item : taken)
+            slots.push_back(*item);
+
+        return true;
+    }
+
+private:
+    std::vector<Item> items;
+};
+
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
 template <class E, bool lowerCase>
 void write_toEnum(std::size_t indent)
@@ -402,6 +536,38 @@ void write_toEnum(std::size_t indent)
     std::cout << std::endl;
 }
 
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+template <class E, bool lowerCase>
+void write_toEnumPh(std::size_t indent)
+{
+    std::string nameStr{introspection::typeName<E>.data(), introspection::typeName<E>.size()-1};
+
+    std::cout << prf(indent) << "/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7" << std::endl;
+    std::cout << prf(indent) << "template <> std::optional<" << nameStr << "> toEnumPh<" << nameStr << ">(std::string_view s)" << std::endl;
+    std::cout << prf(indent) << "{" << std::endl;
+    ++indent;
+
+    std::cout << prf(indent) << "using namespace std::literals::string_view_literals;" << std::endl;
+
+    PerfectHash<lowerCase> perfectHash;
+
+    enumFields<E>([&](auto name, auto value)
+    {
+        if(E{} == value)
+            return;
+
+        std::string fieldNameStr{name.data(), name.size()-1};
+        perfectHash.push(adaptFieldNameString<E>(fieldNameStr), nameStr + "::" + fieldNameStr);
+    });
+
+    perfectHash.build();
+    perfectHash.generateCpp(indent, nameStr);
+
+    --indent;
+    std::cout << prf(indent) << "}" << std::endl;
+    std::cout << std::endl;
+}
+
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
 int main(/*int c_argc, char* c_argv[]*/)
 {
@@ -419,6 +585,8 @@ int main(/*int c_argc, char* c_argv[]*/)
     write_toEnum<firstLine::Version, false>(1);
     write_toEnum<header::KeyRecognized, true>(1);
 
+    write_toEnumPh<header::KeyRecognized, true>(1);
+
     std::cout << "}" << std::endl;
     std::cout << std::endl;
 
@@ -0,0 +1,83 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "http/inputSlicer/scanner.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+using namespace dci::module::www::http::inputSlicer;
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// bytes per tick for scanning a header-like run of given size ending with the terminator
+double measure(auto finder, std::size_t size, char terminator, bool rejectCtl)
+{
+    std::string text;
+    text.reserve(size);
+    static constexpr std::string_view pattern = "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) ";
+    while(text.size() + 1 < size)
+        text += pattern[text.size() % pattern.size()] == terminator ? '_' : pattern[text.size() % pattern.size()];
+    text += terminator;
+
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    std::size_t rounds = std::max<std::size_t>(1, (64u << 20) / text.size());
+    std::uintptr_t sink{};
+
+    std::uint64_t start = ticks();
+    for(std::size_t i{}; i<rounds; ++i)
+    {
+        const char* found = finder(begin, end, terminator, rejectCtl);
+        sink += reinterpret_cast<std::uintptr_t>(found);
+        asm volatile("" : : "r"(sink) : "memory");
+    }
+    std::uint64_t stop = ticks();
+
+    return static_cast<double>(text.size() * rounds) / static_cast<double>(stop - start);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+int main()
+{
+    std::cout << "scanner implementation: " << scanner::implName() << ", units: bytes/cycle (rdtsc)" << std::endl;
+    std::cout << std::setw(8) << "size" << std::setw(6) << "ctl" << std::setw(12) << "scalar" << std::setw(12) << "dispatched" << std::setw(10) << "ratio" << std::endl;
+
+    for(bool rejectCtl : {false, true})
+    {
+        for(std::size_t size : {8, 16, 32, 64, 128, 256, 1024, 4096, 8192})
+        {
+            double scalar = measure(&scanner::findScalar, size, '\r', rejectCtl);
+            double dispatched = measure(&scanner::find, size, '\r', rejectCtl);
+
+            std::cout
+                << std::setw(8) << size
+                << std::setw(6) << (rejectCtl ? "yes" : "no")
+                << std::setw(12) << std::fixed << std::setprecision(3) << scalar
+                << std::setw(12) << std::fixed << std::setprecision(3) << dispatched
+                << std::setw(10) << std::fixed << std::setprecision(2) << dispatched / scalar
+                << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "http/serializer.hpp"
+#include "enumSupport.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+using namespace dci::module::www;
+using namespace dci::module::www::http;
+using KeyRecognized = api::http::header::KeyRecognized;
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+primitives::List<api::http::Header> headers(std::size_t count)
+{
+    static const std::vector<std::pair<KeyRecognized, std::string>> p_typical
+    {
+        {KeyRecognized::Date,           "Sat, 17 Oct 2026 10:00:00 GMT"},
+        {KeyRecognized::Server,         "dci"},
+        {KeyRecognized::Content_Type,   "text/html; charset=utf-8"},
+        {KeyRecognized::Content_Length, "1234"},
+        {KeyRecognized::Cache_Control,  "public, max-age=3600"},
+        {KeyRecognized::ETag,           "\"5f2a-1c8e3b4d\""},
+        {KeyRecognized::Last_Modified,  "Fri, 16 Oct 2026 08:30:00 GMT"},
+        {KeyRecognized::Vary,           "Accept-Encoding"},
+    };
+
+    primitives::List<api::http::Header> res;
+    for(std::size_t i{}; i<count; ++i)
+    {
+        api::http::Header& header = res.emplace_back();
+        if(i < p_typical.size())
+        {
+            header.key = p_typical[i].first;
+            header.value = p_typical[i].second;
+        }
+        else
+        {
+            header.key = api::http::header::KeyAny{"X-Custom-" + std::to_string(i)};
+            header.value = "value-" + std::to_string(i);
+        }
+    }
+
+    return res;
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// the way client::Request serializes: piece by piece into the output bytes
+Bytes piecewise(api::http::firstLine::Method method, std::string_view path, const primitives::List<api::http::Header>& headers)
+{
+    Bytes res;
+    bytes::Alter out{res.end()};
+
+    std::optional<std::string_view> optStr = enumSupport::toString(method);
+    out.write(optStr->data(), optStr->size());
+    out.write(" ");
+    out.write(path.data(), path.size());
+    out.write(" ");
+    optStr = enumSupport::toString(api::http::firstLine::Version::HTTP_1_1);
+    out.write(optStr->data(), optStr->size());
+    out.write("\r\n");
+
+    for(const api::http::Header& header : headers)
+    {
+        header.key.visit([&]<class K>(const K& value)
+        {
+            if constexpr(std::is_same_v<KeyRecognized, K>)
+            {
+                optStr = enumSupport::toString(value);
+                out.write(optStr->data(), optStr->size());
+            }
+            else
+                out.write(value.data(), value.size());
+        });
+
+        out.write(": ");
+        out.write(header.value.data(), header.value.size());
+        out.write("\r\n");
+    }
+
+    out.write("\r\n");
+    return res;
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// the way server::Response serializes: one pre-sized buffer, one write
+Bytes table(const primitives::List<api::http::Header>& headers)
+{
+    std::string head;
+    head.reserve(512);
+    serializer::responseFirstLine(head, api::http::firstLine::Version::HTTP_1_1, 200, {});
+    serializer::headers(head, headers, true);
+
+    Bytes res;
+    res.end().write(head.data(), head.size());
+    return res;
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+// bytes per nanosecond
+double measure(auto serialize)
+{
+    static constexpr std::size_t rounds = 1u << 18;
+    std::size_t bytes{};
+
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i{}; i<rounds; ++i)
+    {
+        Bytes res = serialize();
+        bytes += res.size();
+        asm volatile("" : : "r"(bytes) : "memory");
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    return static_cast<double>(bytes) / static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+int main()
+{
+    {
+        primitives::List<api::http::Header> check = headers(10);
+        check.erase(check.begin() + 1, check.end() - 1);
+
+        std::string expected = "HTTP/1.1 200 OK\r\nDate: Sat, 17 Oct 2026 10:00:00 GMT\r\nX-Custom-9: value-9\r\n\r\n";
+        if(table(check).toString() != expected)
+        {
+            std::cerr << "table serializer output mismatch" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "head serialization, units: bytes/ns" << std::endl;
+    std::cout << std::setw(8) << "headers" << std::setw(12) << "piecewise" << std::setw(12) << "table" << std::setw(10) << "ratio" << std::endl;
+
+    for(std::size_t count : {2, 8, 24})
+    {
+        primitives::List<api::http::Header> hs = headers(count);
+
+        double p = measure([&]{return piecewise(api::http::firstLine::Method::GET, "/index.html", hs);});
+        double t = measure([&]{return table(hs);});
+
+        std::cout
+            << std::setw(8) << count
+            << std::setw(12) << std::fixed << std::setprecision(3) << p
+            << std::setw(12) << std::fixed << std::setprecision(3) << t
+            << std::setw(10) << std::fixed << std::setprecision(2) << t / p
+            << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,8 @@
 #include "www-stiac-support.hpp"
 #include "factory.hpp"
 #include "channelSoftClosing.hpp"
+#include "http/server/dateCache.hpp"
+#include "http/server/compressedCache.hpp"
 
 namespace dci::module::www
 {
@@ -40,6 +42,8 @@ namespace dci::module::www
             bool start(host::Manager* manager) override
             {
                 ChannelSoftClosing::moduleStarted();
+                http::server::DateCache::moduleStarted();
+                http::server::CompressedCache::moduleStarted();
                 return dci::host::module::Entry::start(manager);
             }
 
@@ -51,6 +55,8 @@ namespace dci::module::www
 
             bool stop() override
             {
+                http::server::CompressedCache::moduleStopped();
+                http::server::DateCache::moduleStopped();
                 ChannelSoftClosing::moduleStopped();
                 return dci::host::module::Entry::stop();
             }
@@ -13,12 +13,130 @@ namespace dci::module::www::enumSupport
 {
     template <class E> std::optional<std::string_view> toString(E e);
     template <class E> std::optional<E> toEnum(std::string_view s);
+    template <class E> std::optional<E> toEnumPh(std::string_view s);
+
+    // word level helpers for recognizers, shared by generator and generated code
+    namespace ph
+    {
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // ASCII fold of 8 bytes at once, non-ASCII bytes are left as is
+        constexpr std::uint64_t lowerWord(std::uint64_t w)
+        {
+            constexpr std::uint64_t ones = 0x0101010101010101ull;
+            std::uint64_t heptets = w & (0x7f * ones);
+            std::uint64_t geA = heptets + (0x80 - 'A') * ones;
+            std::uint64_t gtZ = heptets + (0x80 - 'Z' - 1) * ones;
+            std::uint64_t upper = geA & ~gtZ & ~w & (0x80 * ones);
+            return w | (upper >> 2);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        template <bool lowerCase>
+        inline std::uint64_t word(const char* data)
+        {
+            std::uint64_t w;
+            std::memcpy(&w, data, 8);
+            if constexpr(lowerCase)
+                return lowerWord(w);
+            return w;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // less than 8 bytes, with two overlapping fixed size loads instead of a byte loop
+        template <bool lowerCase>
+        inline std::uint64_t shortWord(const char* data, std::size_t size)
+        {
+            dbgAssert(size < 8);
+            std::uint64_t w{};
+            if(size >= 4)
+            {
+                std::uint32_t lo, hi;
+                std::memcpy(&lo, data, 4);
+                std::memcpy(&hi, data + size - 4, 4);
+                w = lo | (std::uint64_t{hi} << ((size - 4) * 8));
+            }
+            else if(size >= 2)
+            {
+                std::uint16_t lo, hi;
+                std::memcpy(&lo, data, 2);
+                std::memcpy(&hi, data + size - 2, 2);
+                w = lo | (std::uint64_t{hi} << ((size - 2) * 8));
+            }
+            else if(size)
+                w = static_cast<unsigned char>(*data);
+
+            if constexpr(lowerCase)
+                return lowerWord(w);
+            return w;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // size, head and tail words; generator refuses a key set with colliding hashes
+        template <bool lowerCase>
+        inline std::uint64_t hash(const char* data, std::size_t size)
+        {
+            std::uint64_t h;
+            if(size < 8)
+                h = (shortWord<lowerCase>(data, size) ^ size) * 0xff51afd7ed558ccdull;
+            else
+            {
+                h = (word<lowerCase>(data) ^ size) * 0xff51afd7ed558ccdull;
+                h ^= word<lowerCase>(data + size - 8) * 0xbf58476d1ce4e5b9ull;
+            }
+            return h ^ (h >> 29);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        constexpr std::uint32_t reduce(std::uint32_t x, std::uint32_t range)
+        {
+            return static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * range) >> 32);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        constexpr std::uint32_t bucket(std::uint64_t h, std::uint32_t bucketsCount)
+        {
+            return reduce(static_cast<std::uint32_t>(h >> 32), bucketsCount);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        constexpr std::uint32_t slot(std::uint64_t h, std::uint16_t displacement, std::uint32_t slotsCount)
+        {
+            return reduce(static_cast<std::uint32_t>(h) ^ (displacement * 0x9e3779b1u), slotsCount);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // the single verification; etalon is stored already folded
+        template <bool lowerCase>
+        inline bool equal(std::string_view s, std::string_view etalon)
+        {
+            std::size_t size = s.size();
+            if(size != etalon.size())
+                return false;
+
+            if(size < 8)
+                return shortWord<lowerCase>(s.data(), size) == shortWord<false>(etalon.data(), size);
+
+            for(std::size_t pos{}; pos + 8 < size; pos += 8)
+                if(word<lowerCase>(s.data() + pos) != word<false>(etalon.data() + pos))
+                    return false;
+
+            return word<lowerCase>(s.data() + size - 8) == word<false>(etalon.data() + size - 8);
+        }
+    }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <int size, bool lowerCase = false>
     constexpr auto asKey(const char* str)
     {
         using Uint = dci::utils::integer::uintCover<size * CHAR_BIT>;
+
+        if constexpr(lowerCase && size > 0 && size <= 8)
+        {
+            // fold the whole word at once instead of byte by byte
+            if(!std::is_constant_evaluated())
+                return static_cast<Uint>(ph::lowerWord(8 == size ? ph::word<false>(str) : ph::shortWord<false>(str, size)));
+        }
+
         char arr[sizeof(Uint)]{};
         for(std::size_t i{}; i<size; ++i)
         {
@@ -57,10 +57,10 @@ namespace dci::module::www
             return cmt::readyFuture(createImpl<http::client::Channel>(std::move(netStreamChannel)));
         };
 
-        // in httpServerChannel(net::stream::Channel) -> http::server::Channel;
-        methods()->httpServerChannel() += sol() * [](idl::net::stream::Channel<> netStreamChannel)
+        // in httpServerChannel(net::stream::Channel, http::server::Settings) -> http::server::Channel;
+        methods()->httpServerChannel() += sol() * [](idl::net::stream::Channel<> netStreamChannel, api::http::server::Settings&& settings)
         {
-            return cmt::readyFuture(createImpl<http::server::Channel>(std::move(netStreamChannel)));
+            return cmt::readyFuture(createImpl<http::server::Channel>(std::move(netStreamChannel), std::move(settings)));
         };
 
         // in http2ClientChannel(net::stream::Channel) -> http2::client::Channel;
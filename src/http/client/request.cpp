@@ -29,6 +29,9 @@ namespace dci::module::www::http::client
             }
             out.write(optStr->data(), optStr->size());
 
+            if(_response)
+                _response->request(method);
+
             out.write(" ");
             out.write(path.data(), path.size());
             out.write(" ");
@@ -98,5 +101,17 @@ namespace dci::module::www::http::client
     Request::~Request()
     {
         _sol.flush();
+
+        if(_response)
+            _response->setRequest(nullptr);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::setResponse(Response* response)
+    {
+        // either side may go first, the other one is unlinked then
+        _response = response;
+        if(_response)
+            _response->setRequest(this);
     }
 }
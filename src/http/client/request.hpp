@@ -26,5 +26,10 @@ namespace dci::module::www::http::client
     public:
         Request(Support* support, api::http::client::Request<>::Opposite&& api);
         ~Request();
+
+        void setResponse(Response* response);
+
+    private:
+        Response* _response{};
     };
 }
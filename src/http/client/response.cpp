@@ -21,12 +21,141 @@ namespace dci::module::www::http::client
     Response::~Response()
     {
         _sol.flush();
+
+        if(_request)
+            _request->setResponse(nullptr);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::setRequest(Request* request)
+    {
+        _request = request;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::request(api::http::firstLine::Method method)
+    {
+        _headRequest = api::http::firstLine::Method::HEAD == method;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    io::InputProcessResult Response::process(bytes::Alter& data)
+    {
+        for(;;)
+        {
+            inputSlicer::Result inputSlicerResult;
+            {
+                inputSlicer::SourceAdapter sa{data};
+                inputSlicerResult = IS::process(sa);
+            }
+
+            switch(inputSlicerResult)
+            {
+            case inputSlicer::Result::needMore:
+                dbgAssert(data.atBegin() && data.atEnd());
+                return io::InputProcessResult::needMore;
+
+            case inputSlicer::Result::done:
+                if(!std::exchange(_interim, false))
+                    return complete();
+
+                // the final response follows in the same data, or in the next portion
+                reset();
+                if(data.atEnd())
+                    return io::InputProcessResult::needMore;
+                continue;
+
+            default:
+                break;
+            }
+
+            fail(inputSlicerResult);
+            return io::InputProcessResult::bad;
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    io::InputProcessResult Response::complete()
+    {
+        reset();
+        if(_api)
+        {
+            if(std::exchange(_bodyless, false))
+                _api->data(Bytes{}, true);
+            _api->done();
+            _api.reset();
+        }
+        return io::InputProcessResult::done;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::fail(inputSlicer::Result inputSlicerResult)
+    {
+        ExceptionPtr err4Fail;
+        switch(inputSlicerResult)
+        {
+        case inputSlicer::Result::badVersion:
+            err4Fail = exception::buildInstance<api::http::error::response::BadVersion>();
+            break;
+
+        case inputSlicer::Result::badStatus:
+            err4Fail = exception::buildInstance<api::http::error::response::BadStatus>();
+            break;
+
+        case inputSlicer::Result::tooBigHeaders:
+            err4Fail = exception::buildInstance<api::http::error::response::TooBigHeaders>();
+            break;
+
+        case inputSlicer::Result::tooBigContent:
+            err4Fail = exception::buildInstance<api::http::error::response::TooBigContent>();
+            break;
+
+        default:
+            err4Fail = exception::buildInstance<api::http::error::response::BadResponse>();
+            break;
+        }
+
+        _support->failed(this, std::move(err4Fail));
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    inputSlicer::Result Response::sliceFlush(inputSlicer::state::ResponseFirstLine& firstLine)
+    {
+        api::http::firstLine::StatusCode statusCode = firstLine._statusCode;
+        if(100 > statusCode)
+            return inputSlicer::Result::badStatus;
+
+        // 101 is final, the connection is switched by it
+        _interim = 200 > statusCode && 101 != statusCode;
+        _bodyless = _headRequest || 200 > statusCode || 204 == statusCode || 304 == statusCode;
+
+        if(!_interim)
+            _api->firstLine(*firstLine._parsedVersion, statusCode, String{firstLine._statusText.str()});
+
+        return IS::sliceFlush(firstLine);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    inputSlicer::Result Response::sliceFlush(inputSlicer::state::Headers& headers, bool done)
+    {
+        primitives::List<api::http::Header> some = headers._conveyor.detachSome();
+
+        if(!_interim)
+            _api->headers(std::move(some), done);
+
+        return IS::sliceFlush(headers, done);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    inputSlicer::Result Response::sliceFlush(inputSlicer::state::Body& body, bool done)
+    {
+        _api->data(std::exchange(body._content, {}), done);
+        return IS::sliceFlush(body, done);
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    io::InputProcessResult Response::process(bytes::Alter& /*data*/)
+    bool Response::sliceBodyless()
     {
-        dbgFatal("not impl");
-        _api->data(Bytes{}, true);
+        return _bodyless;
     }
 }
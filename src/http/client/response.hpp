@@ -10,6 +10,7 @@
 #include "pch.hpp"
 #include "io/plexus.hpp"
 #include "io/inputBase.hpp"
+#include "../inputSlicer.hpp"
 
 namespace dci::module::www::http::client
 {
@@ -19,14 +20,39 @@ namespace dci::module::www::http::client
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     class Response
         : public io::InputBase<io::Plexus<Response, Request, false>, Response, api::http::client::Response<>::Opposite, false>
+        , protected InputSlicer<inputSlicer::Mode::response, Response>
     {
         using Support = io::Plexus<Response, Request, false>;
         using Base = io::InputBase<io::Plexus<Response, Request, false>, Response, api::http::client::Response<>::Opposite, false>;
+        using IS = InputSlicer<inputSlicer::Mode::response, Response>;
 
     public:
         Response(Support* support, api::http::client::Response<>::Opposite api);
         ~Response();
 
+        void setRequest(Request* request);
+        void request(api::http::firstLine::Method method);
         io::InputProcessResult process(bytes::Alter& data);
+
+    private:
+        io::InputProcessResult complete();
+        void fail(inputSlicer::Result inputSlicerResult);
+
+    private:
+        friend IS;
+        inputSlicer::Result sliceFlush(inputSlicer::state::ResponseFirstLine& firstLine);
+        inputSlicer::Result sliceFlush(inputSlicer::state::Headers& headers, bool done);
+        inputSlicer::Result sliceFlush(inputSlicer::state::Body& body, bool done);
+        bool sliceBodyless();
+
+    private:
+        Request* _request{};
+
+        // HEAD responses, 1xx, 204 and 304 have no body whatever their headers say
+        bool _headRequest{};
+        bool _bodyless{};
+
+        // 1xx before the final response, consumed here
+        bool _interim{};
     };
 }
@@ -49,6 +49,7 @@ namespace dci::module::www::http::compress
             static void free(BrotliEncoderState* state){ return BrotliEncoderDestroyInstance(state); }
             static bool step(BrotliEncoderState* state, BufIn& in, BufOut& out, BrotliEncoderOperation op){ return BrotliEncoderCompressStream(state, op, &in._size, &in._ptr, &out._size, &out._ptr, nullptr); }
             static bool finished(BrotliEncoderState *state){ return BrotliEncoderIsFinished(state); }
+            static bool hasMoreOutput(BrotliEncoderState *state){ return BrotliEncoderHasMoreOutput(state); }
         };
 
         /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -90,6 +91,21 @@ namespace dci::module::www::http::compress
         return true;
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <Direction direction>
+    bool Br<direction>::initialize(int quality) requires(Direction::compress == direction)
+    {
+        if(!initialize())
+            return false;
+
+        if(!BrotliEncoderSetParameter(_state, BROTLI_PARAM_QUALITY, static_cast<uint32_t>(quality)))
+        {
+            LOGD(Algo<direction>::name() << " bad quality: " << quality);
+            return false;
+        }
+        return true;
+    }
+
     namespace
     {
         /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -156,6 +172,13 @@ namespace dci::module::www::http::compress
                         LOGD(Algo<direction>::name() << " failed");
                         return {};
                     }
+
+                    // all the source is consumed and flushed or finished
+                    if(BROTLI_OPERATION_PROCESS != op && !ioRoller.getInSize() && !Algo<direction>::hasMoreOutput(_state))
+                    {
+                        if(!finish || Algo<direction>::finished(_state))
+                            break;
+                    }
                 }
                 else
                 {
@@ -168,6 +191,9 @@ namespace dci::module::www::http::compress
 
                     if(BROTLI_DECODER_RESULT_SUCCESS == stepRes)
                         break;
+
+                    if(BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT == stepRes && ioRoller.srcAtFinish() && !ioRoller.getInSize())
+                        break;
                 }
             }
         }
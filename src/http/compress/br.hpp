@@ -21,6 +21,7 @@ namespace dci::module::www::http::compress
         ~Br();
 
         bool initialize();
+        bool initialize(int quality) requires(Direction::compress == direction);
         std::optional<Bytes> exec(Bytes&& content, bool finish);
 
     private:
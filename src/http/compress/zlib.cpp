@@ -22,7 +22,7 @@ namespace dci::module::www::http::compress
         template <> struct Algo<zlib::Type::deflate, Direction::compress>
         {
             static std::string_view name(){ return "deflate"sv; }
-            static int init(z_stream* strm){ return deflateInit2(strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); }
+            static int init(z_stream* strm, int level = Z_DEFAULT_COMPRESSION){ return deflateInit2(strm, level, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); }
             static int end(z_stream* strm){ return deflateEnd(strm); }
             static int step(z_stream* strm, int flush){ return deflate(strm, flush); }
         };
@@ -40,9 +40,9 @@ namespace dci::module::www::http::compress
         template <> struct Algo<zlib::Type::gzip, Direction::compress>
         {
             static std::string_view name(){ return "gzip"sv; }
-            static int init(z_stream* strm)
+            static int init(z_stream* strm, int level = Z_DEFAULT_COMPRESSION)
             {
-                if(int i = deflateInit2(strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS+16 , MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); Z_OK != i)
+                if(int i = deflateInit2(strm, level, Z_DEFLATED, MAX_WBITS+16 , MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); Z_OK != i)
                     return i;
                 gz_header hdr{};
                 return deflateSetHeader(strm, &hdr);
@@ -72,6 +72,21 @@ namespace dci::module::www::http::compress
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <zlib::Type type, Direction direction>
     bool Zlib<type, direction>::initialize()
+    {
+        return doInitialize();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <zlib::Type type, Direction direction>
+    bool Zlib<type, direction>::initialize(int level) requires(Direction::compress == direction)
+    {
+        return doInitialize(level);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <zlib::Type type, Direction direction>
+    template <class... Args>
+    bool Zlib<type, direction>::doInitialize(Args... args)
     {
         dbgAssert(!_initialized);
 
@@ -79,7 +94,7 @@ namespace dci::module::www::http::compress
         _strm.zfree = [](voidpf /*opaque*/, voidpf address){ return mm::heap::free(address); };
         //_strm.opaque = this;
 
-        int i = Algo<type, direction>::init(&_strm);
+        int i = Algo<type, direction>::init(&_strm, args...);
         if(Z_OK != i)
         {
             LOGD(Algo<type, direction>::name() << ": init failed: " << zError(i));
@@ -168,20 +183,27 @@ namespace dci::module::www::http::compress
 
                 int i = Algo<type, direction>::step(&_strm, flushMode);
 
+                // whole source consumed and flushed, or no progress is possible with it
+                bool sourceExhausted = ioRoller.srcAtFinish() && !ioRoller.getInSize();
+
                 switch(i)
                 {
                 case Z_OK:
+                    if(sourceExhausted && ioRoller.getOutSize())
+                        break;
                     continue;
                 case Z_STREAM_END:
                     _dstFinished = true;
                     break;
+                case Z_BUF_ERROR:
+                    if(sourceExhausted)
+                        break;
+                    [[fallthrough]];
                 case Z_NEED_DICT:
                 case Z_DATA_ERROR:
                 case Z_STREAM_ERROR:
                 case Z_MEM_ERROR:
-                case Z_BUF_ERROR:
                 default:
-                    dbgAssert(_strm.msg);
                     if(_strm.msg)
                         LOGD(Algo<type, direction>::name() << " failed: " << zError(i) << ", " << _strm.msg);
                     else
@@ -191,8 +213,7 @@ namespace dci::module::www::http::compress
                     return {};
                 }
 
-                if(_dstFinished)
-                    break;
+                break;
             }
         }
 
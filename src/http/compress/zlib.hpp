@@ -28,8 +28,13 @@ namespace dci::module::www::http::compress
         ~Zlib();
 
         bool initialize();
+        bool initialize(int level) requires(Direction::compress == direction);
         std::optional<Bytes> exec(Bytes&& content, bool finish);
 
+    private:
+        template <class... Args>
+        bool doInitialize(Args... args);
+
     private:
         z_stream _strm{};
         bool _initialized{};
@@ -58,6 +58,21 @@ namespace dci::module::www::http::compress
         return true;
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <Direction direction>
+    bool Zstd<direction>::initialize(int level) requires(Direction::compress == direction)
+    {
+        if(!initialize())
+            return false;
+
+        if(size_t res = ZSTD_CCtx_setParameter(_ctx, ZSTD_c_compressionLevel, level); ZSTD_isError(res))
+        {
+            LOGD(Algo<direction>::name() << " bad level: " << ZSTD_getErrorName(res));
+            return false;
+        }
+        return true;
+    }
+
     namespace
     {
         /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -134,7 +149,13 @@ namespace dci::module::www::http::compress
                     return {};
                 }
 
-                if(!ioRoller.getInSize() && ioRoller.getOutSize()) // пусто на входе и есть место на выходе - это отсутствие прогресса
+                if constexpr(Direction::compress == direction)
+                {
+                    // source consumed, flush or end completed
+                    if(ioRoller.srcAtFinish() && !ioRoller.getInSize() && !stepRes)
+                        break;
+                }
+                else if(ioRoller.srcAtFinish() && !ioRoller.getInSize() && ioRoller.getOutSize()) // пусто на входе и есть место на выходе - это отсутствие прогресса
                 {
                     dstUnflushed = !!stepRes;
                     break;
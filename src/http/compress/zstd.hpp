@@ -20,6 +20,7 @@ namespace dci::module::www::http::compress
         ~Zstd();
 
         bool initialize();
+        bool initialize(int level) requires(Direction::compress == direction);
         std::optional<Bytes> exec(Bytes&& content, bool finish);
 
     private:
@@ -0,0 +1,103 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "httpDate.hpp"
+#include <ctime>
+
+namespace dci::module::www::http::httpDate
+{
+    namespace
+    {
+        constexpr char p_days[7][4]     = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+        constexpr char p_months[12][4]  = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        char* put2(char* pos, int value)
+        {
+            *pos++ = static_cast<char>('0' + value / 10 % 10);
+            *pos++ = static_cast<char>('0' + value % 10);
+            return pos;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        std::optional<int> get(std::string_view str, std::size_t pos, std::size_t size)
+        {
+            int res{};
+            for(char c : str.substr(pos, size))
+            {
+                if('0' > c || '9' < c)
+                    return {};
+                res = res * 10 + (c - '0');
+            }
+            return res;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // proleptic gregorian date to days since 1970-01-01
+        std::int64_t daysFromCivil(int y, int m, int d)
+        {
+            y -= m <= 2;
+            const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+            const std::int64_t yoe = y - era * 400;
+            const std::int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+            const std::int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + doe - 719468;
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void format(std::time_t time, char* out)
+    {
+        std::tm tm{};
+        gmtime_r(&time, &tm);
+
+        char* pos = out;
+        pos = std::copy_n(p_days[tm.tm_wday], 3, pos);
+        pos = std::copy_n(", ", 2, pos);
+        pos = put2(pos, tm.tm_mday);
+        *pos++ = ' ';
+        pos = std::copy_n(p_months[tm.tm_mon], 3, pos);
+        *pos++ = ' ';
+        pos = put2(pos, (tm.tm_year + 1900) / 100);
+        pos = put2(pos, tm.tm_year + 1900);
+        *pos++ = ' ';
+        pos = put2(pos, tm.tm_hour);
+        *pos++ = ':';
+        pos = put2(pos, tm.tm_min);
+        *pos++ = ':';
+        pos = put2(pos, tm.tm_sec);
+        pos = std::copy_n(" GMT", 4, pos);
+        dbgAssert(pos == out + _size);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::optional<std::time_t> parse(std::string_view str)
+    {
+        // obsolete formats are not recognized, the caller then ignores the field
+        if(_size != str.size() || ',' != str[3] || ' ' != str[4] || ' ' != str[7] || ' ' != str[11] ||
+           ' ' != str[16] || ':' != str[19] || ':' != str[22] || " GMT" != str.substr(25))
+            return {};
+
+        int month = 0;
+        for(; month<12; ++month)
+            if(str.substr(8, 3) == p_months[month])
+                break;
+        if(12 == month)
+            return {};
+
+        std::optional<int> day = get(str, 5, 2);
+        std::optional<int> year = get(str, 12, 4);
+        std::optional<int> hour = get(str, 17, 2);
+        std::optional<int> min = get(str, 20, 2);
+        std::optional<int> sec = get(str, 23, 2);
+        if(!day || !year || !hour || !min || !sec || !*day || *day > 31 || *hour > 23 || *min > 59 || *sec > 60)
+            return {};
+
+        return static_cast<std::time_t>(daysFromCivil(*year, month + 1, *day) * 86400 + *hour * 3600 + *min * 60 + *sec);
+    }
+}
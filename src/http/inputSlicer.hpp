@@ -9,6 +9,7 @@
 
 #include "pch.hpp"
 #include "inputSlicer/mode.hpp"
+#include "inputSlicer/limits.hpp"
 #include "inputSlicer/result.hpp"
 #include "inputSlicer/sourceAdapter.hpp"
 #include "inputSlicer/state.hpp"
@@ -26,35 +27,48 @@ namespace dci::module::www::http
         void reset();
         inputSlicer::Result process(inputSlicer::SourceAdapter& sa);
 
+        const inputSlicer::Arena& arena() const;
+        void setLimits(const inputSlicer::Limits& limits);
+
     protected:
         inputSlicer::Result sliceStart();
         inputSlicer::Result sliceFlush(inputSlicer::state::RequestFirstLine& firstLine);
+        inputSlicer::Result sliceFlush(inputSlicer::state::ResponseFirstLine& firstLine);
         inputSlicer::Result sliceFlush(inputSlicer::state::Headers& headers, bool done);
         inputSlicer::Result sliceFlush(inputSlicer::state::Body& body, bool done);
+        inputSlicer::Result sliceExpectContinue();
+        bool sliceBodyless();
 
     private:
         using Processor = inputSlicer::Result (InputSlicer::*)(inputSlicer::SourceAdapter& sa);
 
     private:
         inputSlicer::Result requestNull(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode);
+        inputSlicer::Result requestHead(inputSlicer::SourceAdapter& sa, std::string_view head) requires (inputSlicer::Mode::request == mode);
 
         inputSlicer::Result requestFirstLineMethod(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode);
         inputSlicer::Result requestFirstLineUri(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode);
         inputSlicer::Result requestFirstLineVersion(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode);
 
         inputSlicer::Result responseNull(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::response == mode);
+        inputSlicer::Result responseHead(inputSlicer::SourceAdapter& sa, std::string_view head) requires (inputSlicer::Mode::response == mode);
 
         inputSlicer::Result responseFirstLineVersion(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::response == mode);
         inputSlicer::Result responseFirstLineStatusCode(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::response == mode);
         inputSlicer::Result responseFirstLineStatusText(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::response == mode);
 
         inputSlicer::Result firstLineLF(inputSlicer::SourceAdapter& sa);
+        inputSlicer::Result headersInSegment(inputSlicer::SourceAdapter& sa);
 
         inputSlicer::Result headerPreKey(inputSlicer::SourceAdapter& sa);
         inputSlicer::Result headerKey(inputSlicer::SourceAdapter& sa);
         inputSlicer::Result headerPreValue(inputSlicer::SourceAdapter& sa);
         inputSlicer::Result headerValue(inputSlicer::SourceAdapter& sa);
         inputSlicer::Result headerLF(inputSlicer::SourceAdapter& sa);
+        std::optional<inputSlicer::Result> headerInSegment(inputSlicer::SourceAdapter::ForHdr& saForHdr);
+        inputSlicer::Result headerCommit(std::string_view key, std::string_view value);
+        inputSlicer::Result headerNext(inputSlicer::SourceAdapter& sa);
+        inputSlicer::Result headersDone(inputSlicer::SourceAdapter& sa);
 
         inputSlicer::Result bodyUntilClose(inputSlicer::SourceAdapter& sa);
         inputSlicer::Result bodyByContentLength(inputSlicer::SourceAdapter& sa);
@@ -62,6 +76,8 @@ namespace dci::module::www::http
 
     private:
         Processor _procesor;
+        inputSlicer::Arena _arena;
+        inputSlicer::Limits _limits;
 
     private:
         enum class ActiveState
@@ -10,6 +10,7 @@
 #include "pch.hpp"
 #include "inputSlicer.hpp"
 #include "inputSlicer/accumuleUntil.hpp"
+#include "inputSlicer/scanner.hpp"
 #include "../enumSupport.hpp"
 
 using namespace std::literals;
@@ -30,42 +31,33 @@ namespace
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    inline std::string& ltrim(std::string& s)
+    // tokens in header values are case-insensitive, etalon is given in lower case
+    inline bool tokenIs(std::string_view token, std::string_view etalon)
     {
-        s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](char c){return !isspace(c);}));
-        return s;
+        return dci::module::www::enumSupport::ph::equal<true>(token, etalon);
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    inline std::string&& ltrim(std::string&& s)
+    inline std::string_view ltrim(std::string_view s)
     {
-        return std::move(ltrim(s));
-    }
-
-    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    inline std::string& rtrim(std::string& s)
-    {
-        s.erase(std::find_if(s.rbegin(), s.rend(), [](char c){return !isspace(c);}).base(), s.end());
+        while(!s.empty() && isspace(s.front()))
+            s.remove_prefix(1);
         return s;
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    inline std::string&& rtrim(std::string&& s)
+    inline std::string_view rtrim(std::string_view s)
     {
-        return std::move(rtrim(s));
+        while(!s.empty() && isspace(s.back()))
+            s.remove_suffix(1);
+        return s;
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    inline std::string& trim(std::string& s)
+    inline std::string_view trim(std::string_view s)
     {
         return ltrim(rtrim(s));
     }
-
-    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    inline std::string&& trim(std::string&& s)
-    {
-        return std::move(trim(s));
-    }
 }
 
 namespace dci::module::www::http
@@ -107,6 +99,9 @@ namespace dci::module::www::http
             _procesor = &InputSlicer::responseNull;
             state<inputSlicer::state::ResponseNull, false>();
         }
+
+        // previous message state is destroyed, nobody refers to the arena now
+        _arena.reset();
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -120,6 +115,21 @@ namespace dci::module::www::http
         return res;
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    const inputSlicer::Arena& InputSlicer<mode, Derived>::arena() const
+    {
+        return _arena;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    void InputSlicer<mode, Derived>::setLimits(const inputSlicer::Limits& limits)
+    {
+        // applies from the next message, the current one keeps its envelope
+        _limits = limits;
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::sliceStart()
@@ -135,6 +145,13 @@ namespace dci::module::www::http
         return inputSlicer::Result::done;
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::sliceFlush(inputSlicer::state::ResponseFirstLine& /*firstLine*/)
+    {
+        return inputSlicer::Result::done;
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::sliceFlush(inputSlicer::state::Headers& /*headers*/, bool done)
@@ -149,6 +166,22 @@ namespace dci::module::www::http
         return done ? inputSlicer::Result::done : inputSlicer::Result::needMore;
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::sliceExpectContinue()
+    {
+        // body is read right away
+        return inputSlicer::Result::needMore;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    bool InputSlicer<mode, Derived>::sliceBodyless()
+    {
+        // framing headers decide
+        return false;
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::requestNull(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode)
@@ -158,10 +191,78 @@ namespace dci::module::www::http
             return result;
 
         state<inputSlicer::state::RequestFirstLine, false>();
+
+        // typical request head arrives whole within one segment
+        {
+            static constexpr std::size_t maxHeadSearch = 64 * 1024;
+            static constexpr std::string_view headTerminator = "\r\n\r\n";
+
+            inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+            std::string_view segment{saForHdr.segmentBegin(), std::min(saForHdr.segmentSize(), maxHeadSearch)};
+            std::size_t headSize = segment.find(headTerminator);
+            if(std::string_view::npos != headSize)
+                return requestHead(sa, segment.substr(0, headSize + headTerminator.size()));
+        }
+
         _procesor = &InputSlicer::requestFirstLineMethod;
         return requestFirstLineMethod(sa);
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::requestHead(inputSlicer::SourceAdapter& sa, std::string_view head) requires (inputSlicer::Mode::request == mode)
+    {
+        inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+        inputSlicer::state::RequestFirstLine& stateFirstLine = state<inputSlicer::state::RequestFirstLine>();
+
+        // first line in one pass, anything unusual is left to the incremental states, they diagnose it
+        {
+            const char* begin = head.data();
+            const char* end = head.data() + head.size();
+
+            auto slice = [&](const char*& pos, char terminator, std::size_t limit, bool rejectCtl) -> std::optional<std::string_view>
+            {
+                const char* found = inputSlicer::scanner::find(pos, pos + std::min(static_cast<std::size_t>(end - pos), limit + 1), terminator, rejectCtl);
+                if(end == found || terminator != *found || static_cast<std::size_t>(found - pos) > limit)
+                    return {};
+
+                std::string_view res{pos, found};
+                pos = found + 1;
+                return res;
+            };
+
+            const char* pos = begin;
+            std::optional<std::string_view> method = slice(pos, ' ', stateFirstLine._method.limit(), false);
+            std::optional<std::string_view> uri = method ? slice(pos, ' ', stateFirstLine._uri.limit(), true) : std::nullopt;
+            std::optional<std::string_view> version = uri ? slice(pos, '\r', stateFirstLine._version.limit(), false) : std::nullopt;
+
+            if(version && '\n' == *pos && version->starts_with("HTTP/"))
+            {
+                stateFirstLine._parsedMethod = enumSupport::toEnum<api::http::firstLine::Method>(*method);
+                stateFirstLine._parsedVersion = enumSupport::toEnum<api::http::firstLine::Version>(*version);
+            }
+
+            if(!stateFirstLine._parsedMethod || !stateFirstLine._parsedVersion)
+            {
+                stateFirstLine._parsedMethod.reset();
+                stateFirstLine._parsedVersion.reset();
+                _procesor = &InputSlicer::requestFirstLineMethod;
+                return requestFirstLineMethod(sa);
+            }
+
+            stateFirstLine._method.append(method->begin(), method->end());
+            stateFirstLine._uri.append(uri->begin(), uri->end());
+            stateFirstLine._version.append(version->begin(), version->end());
+            saForHdr.dropFront(static_cast<std::size_t>(pos + 1 - begin));
+        }
+
+        inputSlicer::Result result = static_cast<Derived*>(this)->sliceFlush(stateFirstLine);
+        if(inputSlicer::Result::done != result)
+            return result;
+
+        return headersInSegment(sa);
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::requestFirstLineMethod(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode)
@@ -178,7 +279,7 @@ namespace dci::module::www::http
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::requestFirstLineUri(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::request == mode)
     {
-        inputSlicer::Result result = inputSlicer::accumuleUntil<' ', inputSlicer::Result::tooBigUri>(sa, state<inputSlicer::state::RequestFirstLine>()._uri);
+        inputSlicer::Result result = inputSlicer::accumuleUntil<' ', inputSlicer::Result::tooBigUri, true>(sa, state<inputSlicer::state::RequestFirstLine>()._uri);
         if(inputSlicer::Result::done != result)
             return result;
 
@@ -202,15 +303,81 @@ namespace dci::module::www::http
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::responseNull(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::response == mode)
     {
-        inputSlicer::Result result = static_cast<Derived*>(this)->sliceSart();
+        inputSlicer::Result result = static_cast<Derived*>(this)->sliceStart();
         if(inputSlicer::Result::done != result)
             return result;
 
-        state<inputSlicer::state::ResponseFirstLine, false>().reset();
+        state<inputSlicer::state::ResponseFirstLine, false>();
+
+        // same as for requests, a head within one segment is sliced in place
+        {
+            static constexpr std::size_t maxHeadSearch = 64 * 1024;
+            static constexpr std::string_view headTerminator = "\r\n\r\n";
+
+            inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+            std::string_view segment{saForHdr.segmentBegin(), std::min(saForHdr.segmentSize(), maxHeadSearch)};
+            std::size_t headSize = segment.find(headTerminator);
+            if(std::string_view::npos != headSize)
+                return responseHead(sa, segment.substr(0, headSize + headTerminator.size()));
+        }
+
         _procesor = &InputSlicer::responseFirstLineVersion;
         return responseFirstLineVersion(sa);
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::responseHead(inputSlicer::SourceAdapter& sa, std::string_view head) requires (inputSlicer::Mode::response == mode)
+    {
+        inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+        inputSlicer::state::ResponseFirstLine& stateFirstLine = state<inputSlicer::state::ResponseFirstLine>();
+
+        // status line in one pass, anything unusual is left to the incremental states, they diagnose it
+        {
+            const char* begin = head.data();
+            const char* end = head.data() + head.size();
+
+            const char* pos = inputSlicer::scanner::find(begin, begin + std::min<std::size_t>(head.size(), stateFirstLine._version.limit() + 1), ' ', false);
+            std::string_view version{begin, pos};
+
+            // three digits, then the reason phrase after a space, it may be empty
+            bool good = end - pos > 5 && ' ' == pos[0] && version.starts_with("HTTP/");
+            for(std::size_t i{1}; good && i<4; ++i)
+                good = '0' <= pos[i] && '9' >= pos[i];
+            good = good && (' ' == pos[4] || '\r' == pos[4]);
+
+            std::string_view statusText;
+            if(good)
+            {
+                const char* textBegin = ' ' == pos[4] ? pos + 5 : pos + 4;
+                const char* textEnd = inputSlicer::scanner::find(textBegin, end, '\r', true);
+                good = end - textEnd > 1 && '\r' == textEnd[0] && '\n' == textEnd[1] && static_cast<std::size_t>(textEnd - textBegin) <= stateFirstLine._statusText.limit();
+                statusText = std::string_view{textBegin, textEnd};
+            }
+
+            if(good)
+                stateFirstLine._parsedVersion = enumSupport::toEnum<api::http::firstLine::Version>(version);
+
+            if(!stateFirstLine._parsedVersion)
+            {
+                _procesor = &InputSlicer::responseFirstLineVersion;
+                return responseFirstLineVersion(sa);
+            }
+
+            stateFirstLine._version.append(version.begin(), version.end());
+            stateFirstLine._statusCode = static_cast<std::uint16_t>((pos[1] - '0') * 100 + (pos[2] - '0') * 10 + (pos[3] - '0'));
+            stateFirstLine._statusCodeCharsCount = 4;
+            stateFirstLine._statusText.append(statusText.begin(), statusText.end());
+            saForHdr.dropFront(static_cast<std::size_t>(statusText.data() + statusText.size() + 2 - begin));
+        }
+
+        inputSlicer::Result result = static_cast<Derived*>(this)->sliceFlush(stateFirstLine);
+        if(inputSlicer::Result::done != result)
+            return result;
+
+        return headersInSegment(sa);
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::responseFirstLineVersion(inputSlicer::SourceAdapter& sa) requires (inputSlicer::Mode::response == mode)
@@ -249,10 +416,12 @@ namespace dci::module::www::http
             }
             else
             {
-                if(!isspace(c))
+                // empty reason phrase may come without its space
+                if(' ' != c && '\r' != c)
                     return inputSlicer::Result::badStatus;
 
-                saForHdr.dropFront(1);
+                if(' ' == c)
+                    saForHdr.dropFront(1);
                 ++stateResponseFirstLine._statusCodeCharsCount;
                 break;
             }
@@ -315,7 +484,14 @@ namespace dci::module::www::http
         else
         {
             inputSlicer::state::ResponseFirstLine& stateFirstLine = state<inputSlicer::state::ResponseFirstLine>();
-            dbgFatal("not impl");
+
+            if(!stateFirstLine._version.str().starts_with("HTTP/"))
+                return inputSlicer::Result::badEntity;
+
+            stateFirstLine._parsedVersion = enumSupport::toEnum<api::http::firstLine::Version>(stateFirstLine._version.str());
+            if(!stateFirstLine._parsedVersion)
+                return inputSlicer::Result::badVersion;
+
             result = static_cast<Derived*>(this)->sliceFlush(stateFirstLine);
         }
 
@@ -327,6 +503,44 @@ namespace dci::module::www::http
         return headerPreKey(sa);
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::headersInSegment(inputSlicer::SourceAdapter& sa)
+    {
+        inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+
+        // header lines up to the empty one, no per-line state switching
+        inputSlicer::state::Headers& stateHeaders = state<inputSlicer::state::Headers, false>();
+        while(stateHeaders._conveyor._totalHeadersCount < _limits._headersCount)
+        {
+            const char* line = saForHdr.segmentBegin();
+
+            if('\r' == line[0])
+            {
+                if('\n' != line[1])
+                    break;
+
+                saForHdr.dropFront(2);
+                stateHeaders._conveyor._allowLastValueContinue = false;
+                return headersDone(sa);
+            }
+
+            // folded value continuation
+            if(isspace(line[0]))
+                break;
+
+            std::optional<inputSlicer::Result> lineResult = headerInSegment(saForHdr);
+            if(!lineResult)
+                break;
+
+            if(inputSlicer::Result::needMore != *lineResult)
+                return *lineResult;
+        }
+
+        _procesor = &InputSlicer::headerPreKey;
+        return headerPreKey(sa);
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <inputSlicer::Mode mode, class Derived>
     inputSlicer::Result InputSlicer<mode, Derived>::headerPreKey(inputSlicer::SourceAdapter& sa)
@@ -336,7 +550,7 @@ namespace dci::module::www::http
         inputSlicer::state::Headers& stateHeaders = state<inputSlicer::state::Headers>();
         dbgAssert(inputSlicer::state::Headers::Current::Kind::unknown == stateHeaders._current._kind);
 
-        if(inputSlicer::state::_maxEntityHeadersCount <= stateHeaders._conveyor._totalHeadersCount)
+        if(_limits._headersCount <= stateHeaders._conveyor._totalHeadersCount)
             return inputSlicer::Result::tooBigHeaders;
 
         if(saForHdr.empty())
@@ -364,6 +578,15 @@ namespace dci::module::www::http
             return headerPreValue(sa);
         }
 
+        // whole line is in the segment - slice key and value directly, without accumulation
+        if(std::optional<inputSlicer::Result> result = headerInSegment(saForHdr))
+        {
+            if(inputSlicer::Result::needMore != *result)
+                return *result;
+
+            return headerNext(sa);
+        }
+
         stateHeaders._current._kind = inputSlicer::state::Headers::Current::Kind::regular;
         _procesor = &InputSlicer::headerKey;
         return headerKey(sa);
@@ -379,7 +602,7 @@ namespace dci::module::www::http
         if(sa.empty())
             return inputSlicer::Result::needMore;
 
-        inputSlicer::Result result = inputSlicer::accumuleUntil<':', inputSlicer::Result::badEntity>(sa, stateHeaders._current._key);
+        inputSlicer::Result result = inputSlicer::accumuleUntil<':', inputSlicer::Result::badEntity, true>(sa, stateHeaders._current._key);
         if(inputSlicer::Result::done != result)
             return result;
 
@@ -419,7 +642,7 @@ namespace dci::module::www::http
         dbgAssert(inputSlicer::state::Headers::Current::Kind::regular == stateHeaders._current._kind ||
                   inputSlicer::state::Headers::Current::Kind::valueContinue == stateHeaders._current._kind);
 
-        inputSlicer::Result result = inputSlicer::accumuleUntil<'\r', inputSlicer::Result::tooBigHeaders>(sa, stateHeaders._current._value);
+        inputSlicer::Result result = inputSlicer::accumuleUntil<'\r', inputSlicer::Result::tooBigHeaders, true>(sa, stateHeaders._current._value);
         if(inputSlicer::Result::done != result)
             return result;
 
@@ -452,170 +675,9 @@ namespace dci::module::www::http
             return inputSlicer::Result::badEntity;
 
         case inputSlicer::state::Headers::Current::Kind::regular:
-            {
-                if(!stateHeaders._current._key._size)
-                    return inputSlicer::Result::badEntity;
-
-                for(std::size_t i{}; i<stateHeaders._current._key._size; ++i)
-                {
-                    char c = stateHeaders._current._key._downstream[i];
-                    switch(c)
-                    {
-                    case '(':
-                    case ')':
-                    case '<':
-                    case '>':
-                    case '@':
-                    case ',':
-                    case ';':
-                    case ':':
-                    case '\\':
-                    case '"':
-                    case '/':
-                    case '[':
-                    case ']':
-                    case '?':
-                    case '=':
-                    case '{':
-                    case '}':
-                        return inputSlicer::Result::badEntity;
-                    default:
-                        if(32 >= c || 127 == c)
-                            return inputSlicer::Result::badEntity;
-                    }
-                }
-
-                rtrim(stateHeaders._current._value._downstream);
-                stateHeaders._conveyor._totalValueSize += stateHeaders._current._value._downstream.size();
-                if(inputSlicer::state::_maxEntityHeaderValueSize <= stateHeaders._conveyor._totalValueSize)
-                    return inputSlicer::Result::tooBigHeaders;
-
-                std::optional<api::http::header::KeyRecognized> keyRecognized = enumSupport::toEnum<api::http::header::KeyRecognized>(stateHeaders._current._key.str());
-                if(keyRecognized)
-                {
-                    auto split = [](std::string_view str, std::string_view delims, auto f)
-                    {
-                        std::string_view::size_type pos{};
-                        for(;;)
-                        {
-                            std::string_view::size_type next = str.find_first_of(delims, pos);
-                            std::string_view sub = str.substr(pos, next-pos);
-                            if(!sub.empty())
-                                f(sub);
-                            if(std::string_view::npos == next)
-                                break;
-                            pos = next+1;
-                        }
-                    };
-
-                    auto setCompression = [&](std::string_view type) -> bool
-                    {
-                        if(inputSlicer::state::Headers::BodyRelated::Compression::none != stateHeaders._bodyRelated._compression)
-                            return false;
-
-                        if("compress"sv == type)
-                            return false;
-                        else if("deflate"sv == type)
-                            stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::deflate;
-                        else if("gzip"sv == type)
-                            stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::gzip;
-                        else if("br"sv == type)
-                            stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::br;
-                        else if("zstd"sv == type)
-                            stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::zstd;
-                        else
-                            return false;
-
-                        return true;
-                    };
-
-                    switch(*keyRecognized)
-                    {
-                    case api::http::header::KeyRecognized::Content_Length:
-                        stateHeaders._conveyor._allowLastValueContinue = false;
-
-                        if( inputSlicer::state::Headers::BodyRelated::Portionality::null == stateHeaders._bodyRelated._portionality ||
-                            inputSlicer::state::Headers::BodyRelated::Portionality::untilClose == stateHeaders._bodyRelated._portionality)
-                        {
-                            stateHeaders._bodyRelated._portionality = inputSlicer::state::Headers::BodyRelated::Portionality::byContentLength;
-                        }
-                        else
-                            return inputSlicer::Result::badEntity;
-
-                        {
-                            const char* txtBegin = stateHeaders._current._value._downstream.data();
-                            const char* txtEnd = txtBegin + stateHeaders._current._value._downstream.size();
-                            auto [prsEnd, ec] = std::from_chars(txtBegin, txtEnd, stateHeaders._bodyRelated._contentLength);
-                            if(ec != std::errc{} || prsEnd != txtEnd)
-                                return inputSlicer::Result::badEntity;
-                        }
-                        break;
-                    case api::http::header::KeyRecognized::Content_Encoding:
-                        stateHeaders._conveyor._allowLastValueContinue = false;
-                        {
-                            bool someBadValue = false;
-                            split(stateHeaders._current._value._downstream, ", "sv, [&](std::string_view part)
-                            {
-                                someBadValue |= !setCompression(part);
-                            });
-
-                            if(someBadValue)
-                                return inputSlicer::Result::unprocessableContent;
-                        }
-                        break;
-                    case api::http::header::KeyRecognized::Transfer_Encoding:
-                        stateHeaders._conveyor._allowLastValueContinue = false;
-                        {
-                            bool someBadValue = false;
-                            split(stateHeaders._current._value._downstream, ", "sv, [&](std::string_view part)
-                            {
-                                if("chunked"sv == part)
-                                {
-                                    if( inputSlicer::state::Headers::BodyRelated::Portionality::null == stateHeaders._bodyRelated._portionality ||
-                                        inputSlicer::state::Headers::BodyRelated::Portionality::untilClose == stateHeaders._bodyRelated._portionality)
-                                    {
-                                        stateHeaders._bodyRelated._portionality = inputSlicer::state::Headers::BodyRelated::Portionality::chunked;
-                                    }
-                                    else
-                                        someBadValue = true;
-                                }
-                                else
-                                    someBadValue |= !setCompression(part);
-                            });
-
-                            if(someBadValue)
-                                return inputSlicer::Result::unprocessableContent;
-                        }
-                        break;
-                    case api::http::header::KeyRecognized::Connection:
-                        stateHeaders._conveyor._allowLastValueContinue = false;
-                        if("close"sv == stateHeaders._current._value._downstream)
-                        {
-                            if(inputSlicer::state::Headers::BodyRelated::Portionality::null == stateHeaders._bodyRelated._portionality)
-                                stateHeaders._bodyRelated._portionality = inputSlicer::state::Headers::BodyRelated::Portionality::untilClose;
-                        }
-                        break;
-                    case api::http::header::KeyRecognized::Trailer:
-                        stateHeaders._conveyor._allowLastValueContinue = false;
-                        split(stateHeaders._current._value._downstream, ", "sv, [&](std::string_view part)
-                        {
-                            stateHeaders._bodyRelated._trailers.emplace(part);
-                        });
-                        break;
-                    default:
-                        stateHeaders._conveyor._allowLastValueContinue = true;
-                        break;
-                    }
-
-                    stateHeaders._conveyor._tail.emplace_back(*keyRecognized, std::move(stateHeaders._current._value._downstream));
-                }
-                else
-                {
-                    stateHeaders._conveyor._allowLastValueContinue = true;
-                    stateHeaders._conveyor._tail.emplace_back(api::http::header::KeyAny{stateHeaders._current._key.str()}, std::move(stateHeaders._current._value._downstream));
-                }
-            }
-            result = inputSlicer::Result::needMore;
+            result = headerCommit(stateHeaders._current._key.str(), stateHeaders._current._value.str());
+            if(inputSlicer::Result::needMore != result)
+                return result;
             break;
 
         case inputSlicer::state::Headers::Current::Kind::valueContinue:
@@ -625,15 +687,15 @@ namespace dci::module::www::http
                     return inputSlicer::Result::badEntity;
 
                 std::string& value = stateHeaders._conveyor._tail.back().value;
-                std::string addition = trim(std::move(stateHeaders._current._value._downstream));
+                std::string_view addition = trim(stateHeaders._current._value.str());
 
                 std::size_t totalValueSize = value.size() + 1 + addition.size();
-                if(totalValueSize > decltype(stateHeaders._current._value)::_limit)
+                if(totalValueSize > stateHeaders._current._value.limit())
                     return inputSlicer::Result::tooBigHeaders;
 
                 value.reserve(totalValueSize);
                 value += ' ';
-                value += std::move(addition);
+                value += addition;
             }
             result = inputSlicer::Result::needMore;
             break;
@@ -646,77 +708,357 @@ namespace dci::module::www::http
         switch(result)
         {
         case inputSlicer::Result::needMore:
-            if(saForHdr.empty())
+            return headerNext(sa);
+
+        case inputSlicer::Result::done:
+            return headersDone(sa);
+
+        default:
+            unreacheable();
+        }
+
+        unreacheable();
+        return result;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    std::optional<inputSlicer::Result> InputSlicer<mode, Derived>::headerInSegment(inputSlicer::SourceAdapter::ForHdr& saForHdr)
+    {
+        inputSlicer::state::Headers& stateHeaders = state<inputSlicer::state::Headers>();
+
+        const std::size_t keyLimit = stateHeaders._current._key.limit();
+        const std::size_t valueLimit = stateHeaders._current._value.limit();
+
+        const char* lineBegin = saForHdr.segmentBegin();
+        const char* segmentEnd = saForHdr.segmentEnd();
+
+        const char* keyEnd = inputSlicer::scanner::find(lineBegin, lineBegin + std::min(saForHdr.segmentSize(), keyLimit + 1), ':', true);
+        if(segmentEnd == keyEnd || ':' != *keyEnd || static_cast<std::size_t>(keyEnd - lineBegin) > keyLimit)
+            return {};
+
+        const char* valueBegin = keyEnd + 1;
+        while(segmentEnd != valueBegin && isspace(*valueBegin))
+            ++valueBegin;
+
+        const char* valueEnd = inputSlicer::scanner::find(valueBegin, valueBegin + std::min(static_cast<std::size_t>(segmentEnd - valueBegin), valueLimit + 1), '\r', true);
+        if(segmentEnd == valueEnd || segmentEnd == valueEnd+1 || '\r' != valueEnd[0] || '\n' != valueEnd[1] || static_cast<std::size_t>(valueEnd - valueBegin) > valueLimit)
+            return {};
+
+        ++stateHeaders._conveyor._totalHeadersCount;
+
+        inputSlicer::Result result = headerCommit(std::string_view{lineBegin, keyEnd}, std::string_view{valueBegin, valueEnd});
+        if(inputSlicer::Result::needMore != result)
+            return result;
+
+        saForHdr.dropFront(static_cast<std::size_t>(valueEnd + 2 - lineBegin));
+        return result;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::headerCommit(std::string_view key, std::string_view value)
+    {
+        inputSlicer::state::Headers& stateHeaders = state<inputSlicer::state::Headers>();
+
+        if(key.empty())
+            return inputSlicer::Result::badEntity;
+
+        for(char c : key)
+        {
+            switch(c)
             {
-                result = static_cast<Derived*>(this)->sliceFlush(stateHeaders, false);
-                if(inputSlicer::Result::needMore != result)
-                    return result;
+            case '(':
+            case ')':
+            case '<':
+            case '>':
+            case '@':
+            case ',':
+            case ';':
+            case ':':
+            case '\\':
+            case '"':
+            case '/':
+            case '[':
+            case ']':
+            case '?':
+            case '=':
+            case '{':
+            case '}':
+                return inputSlicer::Result::badEntity;
+            default:
+                if(32 >= c || 127 == c)
+                    return inputSlicer::Result::badEntity;
             }
-            stateHeaders._current.reset();
-            _procesor = &InputSlicer::headerPreKey;
-            return headerPreKey(sa);
+        }
 
-        case inputSlicer::Result::done:
-            result = static_cast<Derived*>(this)->sliceFlush(stateHeaders, true);
-            if(inputSlicer::Result::done != result)
-                return result;
+        value = rtrim(value);
+        stateHeaders._conveyor._totalValueSize += value.size();
+        if(_limits._headersSize <= stateHeaders._conveyor._totalValueSize)
+            return inputSlicer::Result::tooBigHeaders;
 
+#ifdef DCI_MODULE_WWW_HEADER_RECOGNIZER_HASH
+        std::optional<api::http::header::KeyRecognized> keyRecognized = enumSupport::toEnumPh<api::http::header::KeyRecognized>(key);
+#else
+        std::optional<api::http::header::KeyRecognized> keyRecognized = enumSupport::toEnum<api::http::header::KeyRecognized>(key);
+#endif
+        if(keyRecognized)
+        {
+            auto split = [](std::string_view str, std::string_view delims, auto f)
             {
-                auto bodySetup = [compression = stateHeaders._bodyRelated._compression, trailers = std::move(stateHeaders._bodyRelated._trailers)](inputSlicer::state::Body& stateBody)
+                std::string_view::size_type pos{};
+                for(;;)
                 {
-                    stateBody._trailers = std::move(trailers);
-                    switch(compression)
-                    {
-                    case inputSlicer::state::Headers::BodyRelated::Compression::none:
-                        return stateBody._decompressor.emplace<compress::None>().initialize();
-                    case inputSlicer::state::Headers::BodyRelated::Compression::deflate:
-                        return stateBody._decompressor.emplace<compress::Zlib<compress::zlib::Type::deflate, compress::Direction::decompress>>().initialize();
-                    case inputSlicer::state::Headers::BodyRelated::Compression::gzip:
-                        return stateBody._decompressor.emplace<compress::Zlib<compress::zlib::Type::gzip, compress::Direction::decompress>>().initialize();
-                    case inputSlicer::state::Headers::BodyRelated::Compression::br:
-                        return stateBody._decompressor.emplace<compress::Br<compress::Direction::decompress>>().initialize();
-                    case inputSlicer::state::Headers::BodyRelated::Compression::zstd:
-                        return stateBody._decompressor.emplace<compress::Zstd<compress::Direction::decompress>>().initialize();
-                    }
+                    std::string_view::size_type next = str.find_first_of(delims, pos);
+                    std::string_view sub = str.substr(pos, next-pos);
+                    if(!sub.empty())
+                        f(sub);
+                    if(std::string_view::npos == next)
+                        break;
+                    pos = next+1;
+                }
+            };
+
+            auto setCompression = [&](std::string_view type) -> bool
+            {
+                if(inputSlicer::state::Headers::BodyRelated::Compression::none != stateHeaders._bodyRelated._compression)
+                    return false;
+
+                if(tokenIs(type, "compress"sv))
                     return false;
-                };
+                else if(tokenIs(type, "deflate"sv))
+                    stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::deflate;
+                else if(tokenIs(type, "gzip"sv))
+                    stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::gzip;
+                else if(tokenIs(type, "br"sv))
+                    stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::br;
+                else if(tokenIs(type, "zstd"sv))
+                    stateHeaders._bodyRelated._compression = inputSlicer::state::Headers::BodyRelated::Compression::zstd;
+                else
+                    return false;
+
+                return true;
+            };
 
-                switch(stateHeaders._bodyRelated._portionality)
+            switch(*keyRecognized)
+            {
+            case api::http::header::KeyRecognized::Content_Length:
+                stateHeaders._conveyor._allowLastValueContinue = false;
+
+                if( inputSlicer::state::Headers::BodyRelated::Portionality::null == stateHeaders._bodyRelated._portionality ||
+                    inputSlicer::state::Headers::BodyRelated::Portionality::untilClose == stateHeaders._bodyRelated._portionality)
                 {
-                case inputSlicer::state::Headers::BodyRelated::Portionality::null:
-                case inputSlicer::state::Headers::BodyRelated::Portionality::untilClose:
-                    {
-                        static_cast<Derived*>(this)->_emitDataDoneOnClose = true;
+                    stateHeaders._bodyRelated._portionality = inputSlicer::state::Headers::BodyRelated::Portionality::byContentLength;
+                }
+                else
+                    return inputSlicer::Result::badEntity;
 
-                        if(!bodySetup(state<inputSlicer::state::BodyUntilClose, false>()))
-                            return inputSlicer::Result::internalError;
-                        _procesor = &InputSlicer::bodyUntilClose;
-                        return bodyUntilClose(sa);
-                    }
-                case inputSlicer::state::Headers::BodyRelated::Portionality::byContentLength:
+                {
+                    const char* txtBegin = value.data();
+                    const char* txtEnd = txtBegin + value.size();
+                    auto [prsEnd, ec] = std::from_chars(txtBegin, txtEnd, stateHeaders._bodyRelated._contentLength);
+                    if(ec != std::errc{} || prsEnd != txtEnd)
+                        return inputSlicer::Result::badEntity;
+                }
+                break;
+            case api::http::header::KeyRecognized::Content_Encoding:
+                stateHeaders._conveyor._allowLastValueContinue = false;
+                {
+                    bool someBadValue = false;
+                    split(value, ", "sv, [&](std::string_view part)
                     {
-                        auto contentLength = stateHeaders._bodyRelated._contentLength;
-                        inputSlicer::state::BodyByContentLength& bodyState = state<inputSlicer::state::BodyByContentLength, false>();
-                        bodyState._contentLength = contentLength;
-                        if(!bodySetup(bodyState))
-                            return inputSlicer::Result::internalError;
-                        _procesor = &InputSlicer::bodyByContentLength;
-                        return bodyByContentLength(sa);
-                    }
-                case inputSlicer::state::Headers::BodyRelated::Portionality::chunked:
+                        someBadValue |= !setCompression(part);
+                    });
+
+                    if(someBadValue)
+                        return inputSlicer::Result::unprocessableContent;
+                }
+                break;
+            case api::http::header::KeyRecognized::Transfer_Encoding:
+                stateHeaders._conveyor._allowLastValueContinue = false;
+                {
+                    bool conflict = false;
+                    bool someBadValue = false;
+                    split(value, ", "sv, [&](std::string_view part)
                     {
-                        if(!bodySetup(state<inputSlicer::state::BodyChunked, false>()))
-                            return inputSlicer::Result::internalError;
-                        _procesor = &InputSlicer::bodyChunked;
-                        return bodyChunked(sa);
-                    }
+                        stateHeaders._bodyRelated._transferEncoded = true;
+                        stateHeaders._bodyRelated._chunkedLast = tokenIs(part, "chunked"sv);
+
+                        if(stateHeaders._bodyRelated._chunkedLast)
+                        {
+                            if( inputSlicer::state::Headers::BodyRelated::Portionality::null == stateHeaders._bodyRelated._portionality ||
+                                inputSlicer::state::Headers::BodyRelated::Portionality::untilClose == stateHeaders._bodyRelated._portionality)
+                            {
+                                stateHeaders._bodyRelated._portionality = inputSlicer::state::Headers::BodyRelated::Portionality::chunked;
+                            }
+                            else
+                                conflict = true;
+                        }
+                        else
+                            someBadValue |= !setCompression(part);
+                    });
+
+                    // framed twice, the same as Content-Length after chunked
+                    if(conflict)
+                        return inputSlicer::Result::badEntity;
+
+                    if(someBadValue)
+                        return inputSlicer::Result::unprocessableContent;
+                }
+                break;
+            case api::http::header::KeyRecognized::Connection:
+                stateHeaders._conveyor._allowLastValueContinue = false;
+                if(tokenIs(value, "close"sv))
+                {
+                    if(inputSlicer::state::Headers::BodyRelated::Portionality::null == stateHeaders._bodyRelated._portionality)
+                        stateHeaders._bodyRelated._portionality = inputSlicer::state::Headers::BodyRelated::Portionality::untilClose;
                 }
+                break;
+            case api::http::header::KeyRecognized::Expect:
+                stateHeaders._conveyor._allowLastValueContinue = false;
+                if(tokenIs(value, "100-continue"sv))
+                    stateHeaders._bodyRelated._expectContinue = true;
+                break;
+            case api::http::header::KeyRecognized::Trailer:
+                stateHeaders._conveyor._allowLastValueContinue = false;
+                split(value, ", "sv, [&](std::string_view part)
+                {
+                    stateHeaders._bodyRelated._trailers.emplace(part);
+                });
+                break;
+            default:
+                stateHeaders._conveyor._allowLastValueContinue = true;
+                break;
+            }
+
+            stateHeaders._conveyor._tail.emplace_back(*keyRecognized, String{value});
+        }
+        else
+        {
+            stateHeaders._conveyor._allowLastValueContinue = true;
+            stateHeaders._conveyor._tail.emplace_back(api::http::header::KeyAny{key}, String{value});
+        }
+
+        return inputSlicer::Result::needMore;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::headerNext(inputSlicer::SourceAdapter& sa)
+    {
+        inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+        inputSlicer::state::Headers& stateHeaders = state<inputSlicer::state::Headers>();
 
-                unreacheable();
+        if(saForHdr.empty() && stateHeaders._conveyor.batchReady())
+        {
+            inputSlicer::Result result = static_cast<Derived*>(this)->sliceFlush(stateHeaders, false);
+            if(inputSlicer::Result::needMore != result)
+                return result;
+        }
+
+        stateHeaders._current.reset();
+        _procesor = &InputSlicer::headerPreKey;
+        return headerPreKey(sa);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <inputSlicer::Mode mode, class Derived>
+    inputSlicer::Result InputSlicer<mode, Derived>::headersDone(inputSlicer::SourceAdapter& sa)
+    {
+        inputSlicer::state::Headers& stateHeaders = state<inputSlicer::state::Headers>();
+
+        // a request body is delimited by the final chunked coding or Content-Length, never by both,
+        // anything else would be read as the next request (RFC 7230 3.3.3)
+        if constexpr(inputSlicer::Mode::request == mode)
+        {
+            if(stateHeaders._bodyRelated._transferEncoded && !stateHeaders._bodyRelated._chunkedLast)
+                return inputSlicer::Result::badEntity;
+        }
+
+        inputSlicer::Result result = static_cast<Derived*>(this)->sliceFlush(stateHeaders, true);
+        if(inputSlicer::Result::done != result)
+            return result;
+
+        // whatever the headers say, the message ends with them
+        if(static_cast<Derived*>(this)->sliceBodyless())
+            return inputSlicer::Result::done;
+
+        auto bodySetup = [compression = stateHeaders._bodyRelated._compression, trailers = std::move(stateHeaders._bodyRelated._trailers)](inputSlicer::state::Body& stateBody)
+        {
+            stateBody._trailers = std::move(trailers);
+            switch(compression)
+            {
+            case inputSlicer::state::Headers::BodyRelated::Compression::none:
+                return stateBody._decompressor.emplace<compress::None>().initialize();
+            case inputSlicer::state::Headers::BodyRelated::Compression::deflate:
+                return stateBody._decompressor.emplace<compress::Zlib<compress::zlib::Type::deflate, compress::Direction::decompress>>().initialize();
+            case inputSlicer::state::Headers::BodyRelated::Compression::gzip:
+                return stateBody._decompressor.emplace<compress::Zlib<compress::zlib::Type::gzip, compress::Direction::decompress>>().initialize();
+            case inputSlicer::state::Headers::BodyRelated::Compression::br:
+                return stateBody._decompressor.emplace<compress::Br<compress::Direction::decompress>>().initialize();
+            case inputSlicer::state::Headers::BodyRelated::Compression::zstd:
+                return stateBody._decompressor.emplace<compress::Zstd<compress::Direction::decompress>>().initialize();
             }
+            return false;
+        };
 
-        default:
-            unreacheable();
+        switch(stateHeaders._bodyRelated._portionality)
+        {
+        case inputSlicer::state::Headers::BodyRelated::Portionality::null:
+        case inputSlicer::state::Headers::BodyRelated::Portionality::untilClose:
+            // a request without Content-Length or Transfer-Encoding has no body (RFC 7230 3.3.3), only a response runs until close
+            if constexpr(inputSlicer::Mode::request == mode)
+            {
+                inputSlicer::state::BodyByContentLength& bodyState = state<inputSlicer::state::BodyByContentLength, false>();
+                bodyState._contentLength = 0;
+                if(!bodySetup(bodyState))
+                    return inputSlicer::Result::internalError;
+                _procesor = &InputSlicer::bodyByContentLength;
+                return bodyByContentLength(sa);
+            }
+            else
+            {
+                static_cast<Derived*>(this)->_emitDataDoneOnClose = true;
+
+                if(!bodySetup(state<inputSlicer::state::BodyUntilClose, false>()))
+                    return inputSlicer::Result::internalError;
+                _procesor = &InputSlicer::bodyUntilClose;
+                return bodyUntilClose(sa);
+            }
+        case inputSlicer::state::Headers::BodyRelated::Portionality::byContentLength:
+            {
+                auto contentLength = stateHeaders._bodyRelated._contentLength;
+                bool expectContinue = inputSlicer::Mode::request == mode && stateHeaders._bodyRelated._expectContinue && contentLength;
+                inputSlicer::state::BodyByContentLength& bodyState = state<inputSlicer::state::BodyByContentLength, false>();
+                bodyState._contentLength = contentLength;
+                if(!bodySetup(bodyState))
+                    return inputSlicer::Result::internalError;
+                _procesor = &InputSlicer::bodyByContentLength;
+
+                // consumer may hold the body before it is read, processing resumes right in it
+                if(expectContinue)
+                {
+                    result = static_cast<Derived*>(this)->sliceExpectContinue();
+                    if(inputSlicer::Result::needMore != result)
+                        return result;
+                }
+                return bodyByContentLength(sa);
+            }
+        case inputSlicer::state::Headers::BodyRelated::Portionality::chunked:
+            {
+                bool expectContinue = inputSlicer::Mode::request == mode && stateHeaders._bodyRelated._expectContinue;
+                if(!bodySetup(state<inputSlicer::state::BodyChunked, false>()))
+                    return inputSlicer::Result::internalError;
+                _procesor = &InputSlicer::bodyChunked;
+
+                if(expectContinue)
+                {
+                    result = static_cast<Derived*>(this)->sliceExpectContinue();
+                    if(inputSlicer::Result::needMore != result)
+                        return result;
+                }
+                return bodyChunked(sa);
+            }
         }
 
         unreacheable();
@@ -800,6 +1142,53 @@ namespace dci::module::www::http
             switch(stateBody._state)
             {
             case inputSlicer::state::BodyChunked::State::null:
+                {
+                    // run of small chunks complete within the segment - gathered in one pass, no per-byte states
+                    static constexpr std::size_t maxCopiedChunk = 4096;
+
+                    inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+                    const char* begin = saForHdr.segmentBegin();
+                    const char* end = saForHdr.segmentEnd();
+                    const char* pos = begin;
+
+                    Bytes run;
+                    {
+                        bytes::Alter runAlter = run.end();
+                        for(;;)
+                        {
+                            uint32 length;
+                            const char* lengthEnd = inputSlicer::scanner::hex(pos, end, length);
+                            if(lengthEnd == pos || lengthEnd - pos > 7 || !length || length > maxCopiedChunk)
+                                break;
+
+                            if(end - lengthEnd < 2 || '\r' != lengthEnd[0] || '\n' != lengthEnd[1])
+                                break;
+
+                            const char* content = lengthEnd + 2;
+                            if(static_cast<std::size_t>(end - content) < length + 2u || '\r' != content[length] || '\n' != content[length + 1])
+                                break;
+
+                            runAlter.write(content, length);
+                            pos = content + length + 2;
+                        }
+                    }
+
+                    if(begin != pos)
+                    {
+                        saForHdr.dropFront(static_cast<std::size_t>(pos - begin));
+
+                        if(stateBody.needDecompress())
+                        {
+                            std::optional<Bytes> decompressed = stateBody.decompress(std::move(run), false);
+                            if(!decompressed)
+                                return inputSlicer::Result::badEntity;
+                            stateBody._content.end().write(std::move(*decompressed));
+                        }
+                        else
+                            stateBody._content.end().write(std::move(run));
+                    }
+                }
+
                 stateBody._length = 0;
                 stateBody._state = inputSlicer::state::BodyChunked::State::length;
                 break;
@@ -848,7 +1237,7 @@ namespace dci::module::www::http
                     saForHdr.dropFront(1);
                     stateBody._state = stateBody._length ?
                                            inputSlicer::state::BodyChunked::State::content :
-                                           inputSlicer::state::BodyChunked::State::done;
+                                           inputSlicer::state::BodyChunked::State::trailer;
                 }
                 break;
             case inputSlicer::state::BodyChunked::State::content:
@@ -898,6 +1287,52 @@ namespace dci::module::www::http
                     stateBody._state = inputSlicer::state::BodyChunked::State::null;
                 }
                 break;
+            case inputSlicer::state::BodyChunked::State::trailer:
+                {
+                    // trailer fields are consumed up to the empty line, they are not delivered
+                    inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+                    if(saForHdr.empty())
+                        return flush(inputSlicer::Result::needMore);
+                    if('\r' == saForHdr.front())
+                    {
+                        saForHdr.dropFront(1);
+                        stateBody._state = inputSlicer::state::BodyChunked::State::trailerLF;
+                    }
+                    else
+                        stateBody._state = inputSlicer::state::BodyChunked::State::trailerLine;
+                }
+                break;
+            case inputSlicer::state::BodyChunked::State::trailerLine:
+                {
+                    inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+                    if(saForHdr.empty())
+                        return flush(inputSlicer::Result::needMore);
+
+                    const char* begin = saForHdr.segmentBegin();
+                    const char* found = inputSlicer::scanner::find(begin, saForHdr.segmentEnd(), '\n', false);
+                    bool lineEnd = saForHdr.segmentEnd() != found;
+                    std::size_t size = static_cast<std::size_t>(found - begin) + (lineEnd ? 1 : 0);
+
+                    stateBody._trailerSize += size;
+                    if(_limits._headersSize < stateBody._trailerSize)
+                        return inputSlicer::Result::tooBigHeaders;
+
+                    saForHdr.dropFront(size);
+                    if(lineEnd)
+                        stateBody._state = inputSlicer::state::BodyChunked::State::trailer;
+                }
+                break;
+            case inputSlicer::state::BodyChunked::State::trailerLF:
+                {
+                    inputSlicer::SourceAdapter::ForHdr& saForHdr = sa.forHdr();
+                    if(saForHdr.empty())
+                        return flush(inputSlicer::Result::needMore);
+                    if('\n' != saForHdr.front())
+                        return inputSlicer::Result::badEntity;
+                    saForHdr.dropFront(1);
+                    stateBody._state = inputSlicer::state::BodyChunked::State::done;
+                }
+                break;
             case inputSlicer::state::BodyChunked::State::done:
                 return flush(inputSlicer::Result::done);
             }
@@ -970,7 +1405,7 @@ namespace dci::module::www::http
             if constexpr(std::is_same_v<S, inputSlicer::state::RequestFirstLine>)
             {
                 _activeState = ActiveState::requestFirstLine;
-                return *(new (&_requestFirstLine) S);
+                return *(new (&_requestFirstLine) S{_arena, _limits});
             }
 
             if constexpr(std::is_same_v<S, inputSlicer::state::ResponseNull>)
@@ -982,31 +1417,31 @@ namespace dci::module::www::http
             if constexpr(std::is_same_v<S, inputSlicer::state::ResponseFirstLine>)
             {
                 _activeState = ActiveState::responseFirstLine;
-                return *(new (&_responseFirstLine) S);
+                return *(new (&_responseFirstLine) S{_arena});
             }
 
             if constexpr(std::is_same_v<S, inputSlicer::state::Headers>)
             {
                 _activeState = ActiveState::headers;
-                return *(new (&_headers) S);
+                return *(new (&_headers) S{_arena, _limits});
             }
 
             if constexpr(std::is_same_v<S, inputSlicer::state::BodyUntilClose>)
             {
                 _activeState = ActiveState::bodyUntilClose;
-                return *(new (&_bodyUntilClose) S);
+                return *(new (&_bodyUntilClose) S{_arena});
             }
 
             if constexpr(std::is_same_v<S, inputSlicer::state::BodyByContentLength>)
             {
                 _activeState = ActiveState::bodyByContentLength;
-                return *(new (&_bodyByContentLength) S);
+                return *(new (&_bodyByContentLength) S{_arena});
             }
 
             if constexpr(std::is_same_v<S, inputSlicer::state::BodyChunked>)
             {
                 _activeState = ActiveState::bodyChunked;
-                return *(new (&_bodyChunked) S);
+                return *(new (&_bodyChunked) S{_arena});
             }
         }
 
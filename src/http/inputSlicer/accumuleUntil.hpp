@@ -10,11 +10,12 @@
 #include "pch.hpp"
 #include "result.hpp"
 #include "sourceAdapter.hpp"
+#include "scanner.hpp"
 
 namespace dci::module::www::http::inputSlicer
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <char terminator, Result tooBig, class Accumuler>
+    template <char terminator, Result tooBig, bool rejectCtl = false, class Accumuler>
     Result accumuleUntil(SourceAdapter& source, Accumuler& accumuler);
 }
 
@@ -13,22 +13,28 @@
 namespace dci::module::www::http::inputSlicer
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <char terminator, Result tooBig, class Accumuler>
+    template <char terminator, Result tooBig, bool rejectCtl, class Accumuler>
     Result accumuleUntil(SourceAdapter& source, Accumuler& accumuler)
     {
         SourceAdapter::ForHdr& sourceForHdr = source.forHdr();
         while(!sourceForHdr.empty())
         {
-            std::size_t availSize = std::min(sourceForHdr.segmentSize(), Accumuler::_limit - accumuler.size() + 1);
+            std::size_t availSize = std::min(sourceForHdr.segmentSize(), accumuler.limit() - accumuler.size() + 1);
             auto availBegin = sourceForHdr.segmentBegin();
             auto availEnd = availBegin+availSize;
-            auto foundIter = std::find(availBegin, availEnd, terminator);
+            auto foundIter = scanner::find(availBegin, availEnd, terminator, rejectCtl);
 
             std::size_t size4Accumule = foundIter - availBegin;
 
-            if(Accumuler::_limit < accumuler.size() + size4Accumule)
+            if(accumuler.limit() < accumuler.size() + size4Accumule)
                 return tooBig;
 
+            if constexpr(rejectCtl)
+            {
+                if(availEnd != foundIter && terminator != *foundIter)
+                    return Result::badEntity;
+            }
+
             accumuler.append(availBegin, foundIter);
 
             if(availEnd == foundIter)
@@ -0,0 +1,56 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "accumuler.hpp"
+
+namespace dci::module::www::http::inputSlicer
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Accumuler<std::pmr::string>::Accumuler(std::pmr::memory_resource* mr, std::size_t maxSize)
+        : _limit{maxSize}
+        , _downstream{mr}
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Accumuler<std::pmr::string>::reset()
+    {
+        // storage belongs to the arena, keep it for the next header
+        _downstream.clear();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::size_t Accumuler<std::pmr::string>::limit() const
+    {
+        return _limit;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::size_t Accumuler<std::pmr::string>::size() const
+    {
+        return _downstream.size();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Accumuler<std::pmr::string>::empty() const
+    {
+        return _downstream.empty();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::string_view Accumuler<std::pmr::string>::str() const
+    {
+        return _downstream;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::ostream& operator<<(std::ostream& ostr, const Accumuler<std::pmr::string>& acc)
+    {
+        return ostr << acc._downstream;
+    }
+}
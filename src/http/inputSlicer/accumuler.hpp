@@ -12,42 +12,46 @@
 namespace dci::module::www::http::inputSlicer
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <class Downstream, std::size_t limit = Downstream{}.size()> struct Accumuler;
+    template <class Downstream> struct Accumuler;
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <std::size_t limit> struct Accumuler<std::string, limit>
+    // storage grows on demand in the arena, limit is given at runtime
+    template <> struct Accumuler<std::pmr::string>
     {
-        static constexpr std::size_t _limit = limit;
-        std::string _downstream;
+        std::size_t _limit;
+        std::pmr::string _downstream;
+
+        Accumuler(std::pmr::memory_resource* mr, std::size_t maxSize);
 
         void reset();
         template <class Iter> void append(Iter begin, Iter end);
+        std::size_t limit() const;
         std::size_t size() const;
         bool empty() const;
         std::string_view str() const;
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <std::size_t limit>
-    std::ostream& operator<<(std::ostream& ostr, const Accumuler<std::string, limit>& acc);
+    std::ostream& operator<<(std::ostream& ostr, const Accumuler<std::pmr::string>& acc);
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <std::size_t limit> struct Accumuler<std::array<char, limit>, limit>
+    template <std::size_t maxSize> struct Accumuler<std::array<char, maxSize>>
     {
-        static constexpr std::size_t _limit = limit;
+        static constexpr std::size_t _limit = maxSize;
         alignas(8) std::array<char, _limit>  _downstream;
         std::size_t _size{};
 
         void reset();
         template <class Iter> void append(Iter begin, Iter end);
+        static constexpr std::size_t limit();
         std::size_t size() const;
         bool empty() const;
         std::string_view str() const;
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    template <std::size_t limit>
-    std::ostream& operator<<(std::ostream& ostr, const Accumuler<std::array<char, limit>, limit>& acc);
+    template <std::size_t maxSize>
+    std::ostream& operator<<(std::ostream& ostr, const Accumuler<std::array<char, maxSize>>& acc);
 }
 
 #include "accumuler.ipp"
@@ -0,0 +1,125 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "arena.hpp"
+
+namespace dci::module::www::http::inputSlicer
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Arena::Arena()
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Arena::~Arena()
+    {
+        releaseOverflow();
+        ::operator delete(_primary);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Arena::reset()
+    {
+        std::size_t lastUsed = used();
+        _stats._highWater = std::max(_stats._highWater, lastUsed);
+
+        if(_overflow)
+        {
+            releaseOverflow();
+
+            // grow primary block to what the message really took, so the next one fits without the heap
+            std::size_t capacity = std::min(std::bit_ceil(lastUsed), _maxRetainedCapacity);
+            if(capacity > _stats._capacity)
+            {
+                ::operator delete(_primary);
+                _primary = static_cast<char*>(::operator new(capacity));
+                _end = _primary + capacity;
+                _stats._capacity = capacity;
+                ++_stats._upstreamAllocations;
+            }
+        }
+
+        _pos = _primary;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::size_t Arena::used() const
+    {
+        return static_cast<std::size_t>(_pos - _primary) + _overflowUsed;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    const Arena::Stats& Arena::stats() const
+    {
+        return _stats;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void* Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if(!_primary)
+        {
+            _primary = static_cast<char*>(::operator new(_initialCapacity));
+            _pos = _primary;
+            _end = _primary + _initialCapacity;
+            _stats._capacity = _initialCapacity;
+            ++_stats._upstreamAllocations;
+        }
+
+        std::uintptr_t pos = reinterpret_cast<std::uintptr_t>(_pos);
+        std::uintptr_t aligned = (pos + alignment - 1) & ~(alignment - 1);
+        if(aligned + bytes <= reinterpret_cast<std::uintptr_t>(_end))
+        {
+            _pos = reinterpret_cast<char*>(aligned + bytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        return allocateOverflow(bytes, alignment);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Arena::do_deallocate(void* p, std::size_t bytes, std::size_t /*alignment*/)
+    {
+        // the last allocation from the primary block can be rolled back, typical for a growing string
+        if(static_cast<char*>(p) + bytes == _pos)
+            _pos = static_cast<char*>(p);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void* Arena::allocateOverflow(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t size = sizeof(Overflow) + bytes + alignment;
+
+        Overflow* overflow = static_cast<Overflow*>(::operator new(size));
+        overflow->_next = _overflow;
+        overflow->_size = size;
+        _overflow = overflow;
+        _overflowUsed += bytes;
+
+        ++_stats._upstreamAllocations;
+
+        std::uintptr_t data = reinterpret_cast<std::uintptr_t>(overflow + 1);
+        return reinterpret_cast<void*>((data + alignment - 1) & ~(alignment - 1));
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Arena::releaseOverflow()
+    {
+        while(_overflow)
+        {
+            ::operator delete(std::exchange(_overflow, _overflow->_next));
+        }
+        _overflowUsed = 0;
+    }
+}
@@ -0,0 +1,64 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+
+namespace dci::module::www::http::inputSlicer
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // per-connection bump allocator for slicer state, released as a whole between messages
+    class Arena
+        : public std::pmr::memory_resource
+    {
+    public:
+        struct Stats
+        {
+            std::size_t _highWater{};           // max bytes used by one message
+            std::size_t _capacity{};            // bytes retained in the primary block
+            std::size_t _upstreamAllocations{}; // blocks taken from the heap
+        };
+
+    public:
+        Arena();
+        ~Arena() override;
+
+        void reset();
+
+        std::size_t used() const;
+        const Stats& stats() const;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        void* allocateOverflow(std::size_t bytes, std::size_t alignment);
+        void releaseOverflow();
+
+    private:
+        static constexpr std::size_t _initialCapacity = 4096;
+        static constexpr std::size_t _maxRetainedCapacity = 64 * 1024;
+
+        struct Overflow
+        {
+            Overflow*   _next;
+            std::size_t _size;
+        };
+
+        char*       _primary{};
+        char*       _pos{};
+        char*       _end{};
+
+        Overflow*   _overflow{};
+        std::size_t _overflowUsed{};
+
+        Stats       _stats;
+    };
+}
@@ -27,6 +27,9 @@ namespace dci::module::www::http::inputSlicer
         tooBigUri,              //414 URI Too Long
         tooBigHeaders,          //431 Request Header Fields Too Large
         unprocessableContent,   //422 Unprocessable Content
+        timeout,                //408 Request Timeout
+
+        wait,   // consumer holds the message, processing goes on by the next process()
 
         done,
     };
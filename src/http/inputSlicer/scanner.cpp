@@ -0,0 +1,231 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "scanner.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <immintrin.h>
+#   define DCI_MODULE_WWW_SCANNER_X86 1
+#endif
+
+namespace dci::module::www::http::inputSlicer::scanner
+{
+    namespace
+    {
+        using namespace std::string_view_literals;
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        inline bool isForbiddenCtl(char c)
+        {
+            unsigned char uc = static_cast<unsigned char>(c);
+            return (uc < 0x20 && '\t' != c) || 0x7f == uc;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        template <bool rejectCtl>
+        const char* findScalarImpl(const char* begin, const char* end, char terminator)
+        {
+            if constexpr(!rejectCtl)
+                return std::find(begin, end, terminator);
+
+            for(; begin != end; ++begin)
+                if(terminator == *begin || isForbiddenCtl(*begin))
+                    break;
+
+            return begin;
+        }
+
+#ifdef DCI_MODULE_WWW_SCANNER_X86
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        template <bool rejectCtl>
+        __attribute__((target("sse2")))
+        const char* findSse2(const char* begin, const char* end, char terminator)
+        {
+            const __m128i term  = _mm_set1_epi8(terminator);
+            const __m128i ctl   = _mm_set1_epi8(0x1f);
+            const __m128i tab   = _mm_set1_epi8('\t');
+            const __m128i del   = _mm_set1_epi8(0x7f);
+
+            while(end - begin >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+                __m128i stop = _mm_cmpeq_epi8(v, term);
+
+                if constexpr(rejectCtl)
+                {
+                    // unsigned v <= 0x1f, except tab; and DEL
+                    __m128i low = _mm_andnot_si128(_mm_cmpeq_epi8(v, tab), _mm_cmpeq_epi8(_mm_min_epu8(v, ctl), v));
+                    stop = _mm_or_si128(stop, _mm_or_si128(low, _mm_cmpeq_epi8(v, del)));
+                }
+
+                if(unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(stop)))
+                    return begin + std::countr_zero(mask);
+
+                begin += 16;
+            }
+
+            return findScalarImpl<rejectCtl>(begin, end, terminator);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        template <bool rejectCtl>
+        __attribute__((target("avx2")))
+        const char* findAvx2(const char* begin, const char* end, char terminator)
+        {
+            const __m256i term  = _mm256_set1_epi8(terminator);
+            const __m256i ctl   = _mm256_set1_epi8(0x1f);
+            const __m256i tab   = _mm256_set1_epi8('\t');
+            const __m256i del   = _mm256_set1_epi8(0x7f);
+
+            while(end - begin >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+                __m256i stop = _mm256_cmpeq_epi8(v, term);
+
+                if constexpr(rejectCtl)
+                {
+                    __m256i low = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab), _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctl), v));
+                    stop = _mm256_or_si256(stop, _mm256_or_si256(low, _mm256_cmpeq_epi8(v, del)));
+                }
+
+                if(unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(stop)))
+                    return begin + std::countr_zero(mask);
+
+                begin += 32;
+            }
+
+            // tail shorter than a ymm register, typical for short tokens
+            return findSse2<rejectCtl>(begin, end, terminator);
+        }
+#endif
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        struct Impl
+        {
+            using Finder = const char* (*)(const char* begin, const char* end, char terminator);
+
+            Finder              _plain;
+            Finder              _rejectCtl;
+            std::string_view    _name;
+        };
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        Impl resolve()
+        {
+#ifdef DCI_MODULE_WWW_SCANNER_X86
+            __builtin_cpu_init();
+
+            if(__builtin_cpu_supports("avx2"))
+                return {&findAvx2<false>, &findAvx2<true>, "avx2"sv};
+
+            if(__builtin_cpu_supports("sse2"))
+                return {&findSse2<false>, &findSse2<true>, "sse2"sv};
+#endif
+            return {&findScalarImpl<false>, &findScalarImpl<true>, "scalar"sv};
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        const Impl p_impl = resolve();
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        const Impl& impl()
+        {
+            return p_impl;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // below this size an indirect call costs more than a plain loop
+        constexpr std::ptrdiff_t _minVectorSize = 16;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    const char* find(const char* begin, const char* end, char terminator, bool rejectCtl)
+    {
+        if(end - begin < _minVectorSize)
+            return findScalar(begin, end, terminator, rejectCtl);
+
+        return rejectCtl ?
+                   impl()._rejectCtl(begin, end, terminator) :
+                   impl()._plain(begin, end, terminator);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    const char* findScalar(const char* begin, const char* end, char terminator, bool rejectCtl)
+    {
+        return rejectCtl ?
+                   findScalarImpl<true>(begin, end, terminator) :
+                   findScalarImpl<false>(begin, end, terminator);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    const char* hex(const char* begin, const char* end, uint32& value)
+    {
+        if(end - begin < 8)
+        {
+            value = 0;
+            const char* pos = begin;
+            for(; pos != end && pos - begin < 8; ++pos)
+            {
+                char c = *pos;
+                if('0' <= c && '9' >= c)
+                    value = (value << 4) | static_cast<uint32>(c - '0');
+                else if('a' <= c && 'f' >= c)
+                    value = (value << 4) | static_cast<uint32>(c + 10 - 'a');
+                else if('A' <= c && 'F' >= c)
+                    value = (value << 4) | static_cast<uint32>(c + 10 - 'A');
+                else
+                    break;
+            }
+            return pos;
+        }
+
+        // eight characters at once, first one in the low byte
+        std::uint64_t x;
+        std::memcpy(&x, begin, 8);
+        if constexpr(std::endian::big == std::endian::native)
+            x = __builtin_bswap64(x);
+
+        static constexpr std::uint64_t ones = 0x0101010101010101ull;
+        static constexpr std::uint64_t high = 0x8080808080808080ull;
+
+        // high bit of a byte set where it is in [lo, hi], for ascii bytes
+        auto in = [&](std::uint8_t lo, std::uint8_t hi)
+        {
+            std::uint64_t geLo = (x | high) - ones * lo;
+            std::uint64_t gtHi = (x | high) - ones * (hi + 1u);
+            return geLo & ~gtHi & ~x & high;
+        };
+
+        std::uint64_t letters = in('a', 'f') | in('A', 'F');
+        std::uint64_t digits = in('0', '9') | letters;
+
+        std::size_t count = static_cast<std::size_t>(std::countr_zero(~digits & high)) / 8;
+        if(!count)
+        {
+            value = 0;
+            return begin;
+        }
+
+        // nibbles, most significant digits in the low bytes; move them out of the way of the shorter numbers
+        std::uint64_t n = (x & (ones * 0x0f)) + (letters >> 7) * 9;
+        n <<= (8 - count) * 8;
+
+        n = ((n & 0x000f000f000f000full) << 4) | ((n & 0x0f000f000f000f00ull) >> 8);
+        n = ((n & 0x000000ff000000ffull) << 8) | ((n & 0x00ff000000ff0000ull) >> 16);
+        n = ((n & 0x000000000000ffffull) << 16) | ((n & 0x0000ffff00000000ull) >> 32);
+
+        value = static_cast<uint32>(n);
+        return begin + count;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::string_view implName()
+    {
+        return impl()._name;
+    }
+}
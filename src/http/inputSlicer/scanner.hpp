@@ -0,0 +1,30 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+
+namespace dci::module::www::http::inputSlicer::scanner
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // first position of terminator in [begin, end) or end if absent
+    // with rejectCtl also stops on control bytes forbidden in header fields (CTL except HTAB, and DEL)
+    const char* find(const char* begin, const char* end, char terminator, bool rejectCtl);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // the same without vector extensions, reference for tests and benchmarks
+    const char* findScalar(const char* begin, const char* end, char terminator, bool rejectCtl);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // leading hex digits of [begin, end), at most 8 of them, as a chunk size
+    // returns the end of the digits, begin if there are none
+    const char* hex(const char* begin, const char* end, uint32& value);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::string_view implName();
+}
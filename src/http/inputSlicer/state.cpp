@@ -10,6 +10,32 @@
 
 namespace dci::module::www::http::inputSlicer::state
 {
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    RequestFirstLine::RequestFirstLine(Arena& arena, const Limits& limits)
+        : _uri{&arena, limits._uriSize}
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    ResponseFirstLine::ResponseFirstLine(Arena& arena)
+        : _statusText{&arena, _maxStatusTextSize}
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Headers::Headers(Arena& arena, const Limits& limits)
+        : _current{arena, limits}
+        , _bodyRelated{arena}
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Headers::Current::Current(Arena& arena, const Limits& limits)
+        : _key{&arena, limits._headerKeySize}
+        , _value{&arena, limits._headerValueSize}
+    {
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     void Headers::Current::reset()
     {
@@ -27,6 +53,22 @@ namespace dci::module::www::http::inputSlicer::state
         return !_tail.empty();
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Headers::Сonveyor::batchReady() const
+    {
+        if(!canDetachSome())
+            return false;
+
+        if(_tail.size() >= _headersBatchCount)
+            return true;
+
+        std::size_t size{};
+        for(const api::http::Header& header : _tail)
+            size += header.value.size();
+
+        return size >= _headersBatchSize;
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     primitives::List<api::http::Header> Headers::Сonveyor::detachSome()
     {
@@ -47,6 +89,18 @@ namespace dci::module::www::http::inputSlicer::state
         return std::exchange(_tail, {});
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Headers::BodyRelated::BodyRelated(Arena& arena)
+        : _trailers{&arena}
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Body::Body(Arena& arena)
+        : _trailers{&arena}
+    {
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     bool Body::needDecompress()
     {
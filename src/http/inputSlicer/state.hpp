@@ -9,6 +9,8 @@
 
 #include "pch.hpp"
 #include "accumuler.hpp"
+#include "arena.hpp"
+#include "limits.hpp"
 #include "../compress/none.hpp"
 #include "../compress/zlib.hpp"
 #include "../compress/br.hpp"
@@ -16,6 +18,9 @@
 
 namespace dci::module::www::http::inputSlicer::state
 {
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    using Trailers = std::pmr::set<std::pmr::string, std::less<>>;
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct RequestNull
     {
@@ -24,8 +29,10 @@ namespace dci::module::www::http::inputSlicer::state
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct RequestFirstLine
     {
+        RequestFirstLine(Arena& arena, const Limits& limits);
+
         Accumuler<std::array<char, 32>> _method;
-        Accumuler<std::string, 8192>    _uri;
+        Accumuler<std::pmr::string> _uri;
         Accumuler<std::array<char, 16>> _version;
 
         std::optional<api::http::firstLine::Method>     _parsedMethod;
@@ -38,21 +45,31 @@ namespace dci::module::www::http::inputSlicer::state
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    constexpr std::size_t _maxStatusTextSize{64};
+
     struct ResponseFirstLine
     {
+        explicit ResponseFirstLine(Arena& arena);
+
         Accumuler<std::array<char, 16>> _version;
         std::uint16_t                   _statusCode{};
         std::uint16_t                   _statusCodeCharsCount{};
-        Accumuler<std::string, 64>      _statusText;
+        Accumuler<std::pmr::string> _statusText;
+
+        std::optional<api::http::firstLine::Version>    _parsedVersion;
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct Headers
     {
+        Headers(Arena& arena, const Limits& limits);
+
         struct Current
         {
-            Accumuler<std::array<char, 64>> _key;
-            Accumuler<std::string, 8192>    _value;
+            Current(Arena& arena, const Limits& limits);
+
+            Accumuler<std::pmr::string> _key;
+            Accumuler<std::pmr::string> _value;
 
             enum class Kind
             {
@@ -73,12 +90,15 @@ namespace dci::module::www::http::inputSlicer::state
             bool                                _allowLastValueContinue{};
 
             bool canDetachSome() const;
+            bool batchReady() const;
             primitives::List<api::http::Header> detachSome();
 
         } _conveyor;
 
         struct BodyRelated
         {
+            explicit BodyRelated(Arena& arena);
+
             enum class Portionality
             {
                 null,
@@ -89,6 +109,10 @@ namespace dci::module::www::http::inputSlicer::state
 
             uint64 _contentLength{};
 
+            // a request body is delimited only if the last transfer coding is chunked
+            bool _transferEncoded{};
+            bool _chunkedLast{};
+
             enum class Compression
             {
                 none,
@@ -98,15 +122,22 @@ namespace dci::module::www::http::inputSlicer::state
                 zstd,
             } _compression{};
 
-            Set<String> _trailers;
+            // the body is not sent until the client gets 100 Continue, or a timeout of it
+            bool _expectContinue{};
+
+            Trailers _trailers;
         } _bodyRelated;
     };
-    constexpr std::size_t _maxEntityHeadersCount{256}; // VS Headers::_conveyor._totalHeadersCount
-    constexpr std::size_t _maxEntityHeaderValueSize{32768}; // VS Headers::_conveyor._totalValueSize
+
+    // incomplete head is delivered by portions of this many headers or value bytes, complete one at once
+    constexpr std::size_t _headersBatchCount{32};
+    constexpr std::size_t _headersBatchSize{4096};
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct Body
     {
+        explicit Body(Arena& arena);
+
         using Decompressor = Variant
         <
             compress::None,
@@ -121,23 +152,28 @@ namespace dci::module::www::http::inputSlicer::state
         std::optional<Bytes> decompress(Bytes&& content, bool finish);
 
         Bytes _content;
-        Set<String> _trailers;
+        Trailers _trailers;
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct BodyUntilClose : Body
     {
+        using Body::Body;
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct BodyByContentLength : Body
     {
+        using Body::Body;
+
         uint64 _contentLength{};
     };
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     struct BodyChunked : Body
     {
+        using Body::Body;
+
         enum State
         {
             null,
@@ -145,8 +181,10 @@ namespace dci::module::www::http::inputSlicer::state
             LF0,
             content,
             CR1, LF1,
+            trailer, trailerLine, trailerLF,
             done
         } _state{};
         uint32 _length{};
+        std::size_t _trailerSize{};
     };
 }
@@ -0,0 +1,284 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "serializer.hpp"
+#include "inputSlicer/scanner.hpp"
+#include "../enumSupport.hpp"
+
+namespace dci::module::www::http::serializer
+{
+    namespace
+    {
+        using StatusCode = api::http::firstLine::StatusCode;
+        using Version = api::http::firstLine::Version;
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        struct Reason
+        {
+            StatusCode          _code;
+            std::string_view    _text;
+        };
+
+        constexpr Reason p_reasons[]
+        {
+            {100, "Continue"},
+            {101, "Switching Protocols"},
+            {103, "Early Hints"},
+            {200, "OK"},
+            {201, "Created"},
+            {202, "Accepted"},
+            {203, "Non-Authoritative Information"},
+            {204, "No Content"},
+            {205, "Reset Content"},
+            {206, "Partial Content"},
+            {300, "Multiple Choices"},
+            {301, "Moved Permanently"},
+            {302, "Found"},
+            {303, "See Other"},
+            {304, "Not Modified"},
+            {307, "Temporary Redirect"},
+            {308, "Permanent Redirect"},
+            {400, "Bad Request"},
+            {401, "Unauthorized"},
+            {402, "Payment Required"},
+            {403, "Forbidden"},
+            {404, "Not Found"},
+            {405, "Method Not Allowed"},
+            {406, "Not Acceptable"},
+            {407, "Proxy Authentication Required"},
+            {408, "Request Timeout"},
+            {409, "Conflict"},
+            {410, "Gone"},
+            {411, "Length Required"},
+            {412, "Precondition Failed"},
+            {413, "Content Too Large"},
+            {414, "URI Too Long"},
+            {415, "Unsupported Media Type"},
+            {416, "Range Not Satisfiable"},
+            {417, "Expectation Failed"},
+            {421, "Misdirected Request"},
+            {422, "Unprocessable Content"},
+            {425, "Too Early"},
+            {426, "Upgrade Required"},
+            {428, "Precondition Required"},
+            {429, "Too Many Requests"},
+            {431, "Request Header Fields Too Large"},
+            {451, "Unavailable For Legal Reasons"},
+            {500, "Internal Server Error"},
+            {501, "Not Implemented"},
+            {502, "Bad Gateway"},
+            {503, "Service Unavailable"},
+            {504, "Gateway Timeout"},
+            {505, "HTTP Version Not Supported"},
+            {511, "Network Authentication Required"},
+        };
+
+        constexpr StatusCode _minStatusCode = 100;
+        constexpr StatusCode _maxStatusCode = 999;
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // complete status lines for the known codes, per version having a status line
+        struct StatusLines
+        {
+            static constexpr Version _versions[] = {Version::HTTP_1_0, Version::HTTP_1_1};
+
+            std::array<std::string_view, 600>   _reasons;
+            std::array<std::array<std::string, 600>, std::size(_versions)> _lines;
+
+            StatusLines()
+            {
+                for(const Reason& reason : p_reasons)
+                    _reasons[reason._code] = reason._text;
+
+                for(std::size_t v{}; v<std::size(_versions); ++v)
+                {
+                    std::string_view versionStr = *enumSupport::toString(_versions[v]);
+                    for(const Reason& reason : p_reasons)
+                    {
+                        std::string& line = _lines[v][reason._code];
+                        line.reserve(versionStr.size() + 5 + reason._text.size() + 2);
+                        line += versionStr;
+                        line += ' ';
+                        line += std::to_string(reason._code);
+                        line += ' ';
+                        line += reason._text;
+                        line += "\r\n";
+                    }
+                }
+            }
+
+            std::string_view line(Version version, StatusCode statusCode) const
+            {
+                if(statusCode >= _lines[0].size())
+                    return {};
+
+                for(std::size_t v{}; v<std::size(_versions); ++v)
+                    if(_versions[v] == version)
+                        return _lines[v][statusCode];
+
+                return {};
+            }
+        };
+
+        const StatusLines p_statusLines;
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        bool isToken(std::string_view s)
+        {
+            if(s.empty())
+                return false;
+
+            for(char c : s)
+            {
+                switch(c)
+                {
+                case '(': case ')': case '<': case '>': case '@': case ',': case ';': case ':':
+                case '\\': case '"': case '/': case '[': case ']': case '?': case '=': case '{': case '}':
+                    return false;
+                default:
+                    if(32 >= c || 127 == c)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // field content must not break the framing
+        bool isFieldValue(std::string_view s)
+        {
+            const char* end = s.data() + s.size();
+            return end == inputSlicer::scanner::find(s.data(), end, '\n', true);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        std::string_view keyStr(const api::http::header::Key& key)
+        {
+            if(key.holds<api::http::header::KeyRecognized>())
+                return enumSupport::toString(key.get<api::http::header::KeyRecognized>()).value_or(std::string_view{});
+
+            return key.get<api::http::header::KeyAny>();
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::string_view reasonPhrase(api::http::firstLine::StatusCode statusCode)
+    {
+        if(statusCode >= p_statusLines._reasons.size())
+            return {};
+
+        return p_statusLines._reasons[statusCode];
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Result responseFirstLine(std::string& out, api::http::firstLine::Version version, api::http::firstLine::StatusCode statusCode, std::string_view statusText)
+    {
+        if(_minStatusCode > statusCode || _maxStatusCode < statusCode)
+            return Result::badStatus;
+
+        if(statusText.empty() || statusText == reasonPhrase(statusCode))
+        {
+            std::string_view line = p_statusLines.line(version, statusCode);
+            if(!line.empty())
+            {
+                out += line;
+                return Result::ok;
+            }
+
+            statusText = reasonPhrase(statusCode);
+        }
+
+        std::optional<std::string_view> versionStr = enumSupport::toString(version);
+        if(!versionStr || Version::null == version)
+            return Result::badVersion;
+
+        if(!isFieldValue(statusText))
+            return Result::badStatus;
+
+        const char digits[3] =
+        {
+            static_cast<char>('0' + statusCode / 100),
+            static_cast<char>('0' + statusCode / 10 % 10),
+            static_cast<char>('0' + statusCode % 10),
+        };
+
+        out.reserve(out.size() + versionStr->size() + 5 + statusText.size() + 2);
+        out += *versionStr;
+        out += ' ';
+        out.append(digits, 3);
+        out += ' ';
+        out += statusText;
+        out += "\r\n";
+
+        return Result::ok;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Result requestFirstLine(std::string& out, api::http::firstLine::Method method, std::string_view path, api::http::firstLine::Version version)
+    {
+        std::optional<std::string_view> methodStr = enumSupport::toString(method);
+        if(!methodStr || api::http::firstLine::Method::null == method)
+            return Result::badMethod;
+
+        std::optional<std::string_view> versionStr = enumSupport::toString(version);
+        if(!versionStr || Version::null == version)
+            return Result::badVersion;
+
+        out.reserve(out.size() + methodStr->size() + 1 + path.size() + 1 + versionStr->size() + 2);
+        out += *methodStr;
+        out += ' ';
+        out += path;
+        out += ' ';
+        out += *versionStr;
+        out += "\r\n";
+
+        return Result::ok;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Result headers(std::string& out, const primitives::List<api::http::Header>& headers, bool done, std::span<const api::http::header::KeyRecognized> skip)
+    {
+        auto skipped = [&](const api::http::Header& header)
+        {
+            return !skip.empty() && header.key.holds<api::http::header::KeyRecognized>() &&
+                   skip.end() != std::find(skip.begin(), skip.end(), header.key.get<api::http::header::KeyRecognized>());
+        };
+
+        std::size_t size = done ? 2 : 0;
+        for(const api::http::Header& header : headers)
+        {
+            if(skipped(header))
+                continue;
+
+            std::string_view key = keyStr(header.key);
+            if(!isToken(key) || !isFieldValue(header.value))
+                return Result::badHeader;
+
+            size += key.size() + 2 + header.value.size() + 2;
+        }
+
+        out.reserve(out.size() + size);
+
+        for(const api::http::Header& header : headers)
+        {
+            if(skipped(header))
+                continue;
+
+            out += keyStr(header.key);
+            out += ": ";
+            out += header.value;
+            out += "\r\n";
+        }
+
+        if(done)
+            out += "\r\n";
+
+        return Result::ok;
+    }
+}
@@ -0,0 +1,35 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+
+namespace dci::module::www::http::serializer
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    enum class Result
+    {
+        ok,
+        badMethod,
+        badVersion,
+        badStatus,
+        badHeader,
+    };
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // standard reason phrase, empty for unknown codes
+    std::string_view reasonPhrase(api::http::firstLine::StatusCode statusCode);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // append to out, growing it once by the exact size of the serialized piece
+    // empty statusText means the standard reason phrase
+    Result responseFirstLine(std::string& out, api::http::firstLine::Version version, api::http::firstLine::StatusCode statusCode, std::string_view statusText);
+    Result requestFirstLine(std::string& out, api::http::firstLine::Method method, std::string_view path, api::http::firstLine::Version version);
+    // headers with the skip keys are left out, the caller is to take care of them
+    Result headers(std::string& out, const primitives::List<api::http::Header>& headers, bool done, std::span<const api::http::header::KeyRecognized> skip = {});
+}
@@ -7,17 +7,46 @@
 
 #include "pch.hpp"
 #include "channel.hpp"
+#include "settings.hpp"
 
 namespace dci::module::www::http::server
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    Channel::Channel(idl::net::stream::Channel<> netStreamChannel)
+    Channel::Channel(idl::net::stream::Channel<> netStreamChannel, api::http::server::Settings&& settings)
         : api::http::server::Channel<>::Opposite{idl::interface::Initializer{}}
         , io::Plexus<Request, Response, true>{std::move(netStreamChannel), *this}
+        , _settings{settings::applyDefaults(std::move(settings))}
     {
+        limitInFlight(_settings.maxInFlight);
+        limitOutput(_settings.outputHighWatermark, _settings.outputLowWatermark);
+        input().setLimits(settings::inputLimits(_settings));
+        if(_settings.idleTimeout)
+            limitIdle(std::chrono::milliseconds{_settings.idleTimeout});
+        if(_settings.headTimeout)
+            input().limitHead(std::chrono::milliseconds{_settings.headTimeout});
+        if(_settings.maxRequests)
+            input().limitRequests(_settings.maxRequests);
+        input().limitBodyCredit(_settings.bodyWindow);
+        if(_settings.minBodyRate && _settings.bodyRateWindow)
+            input().limitBodyRate(_settings.minBodyRate, std::chrono::milliseconds{_settings.bodyRateWindow});
+
         // out upgradeHttp2(www::Channel::Opposite http2ServerChannel) -> bool;
         // out upgradeWs(www::Channel::Opposite wsChannel) -> bool;
         // out io(Request::Opposite, Response::Opposite);
+
+        // in stats() -> Stats;
+        methods()->stats() += _sol * [this]()
+        {
+            const inputSlicer::Arena& arena = input().arena();
+
+            api::http::server::Stats stats;
+            stats.arenaUsed = arena.used();
+            stats.arenaHighWater = arena.stats()._highWater;
+            stats.arenaCapacity = arena.stats()._capacity;
+            stats.arenaAllocations = arena.stats()._upstreamAllocations;
+            stats.outputQueued = outputQueued();
+            return cmt::readyFuture(std::move(stats));
+        };
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -30,7 +59,7 @@ namespace dci::module::www::http::server
     void Channel::emitIo(api::http::server::Request<> request)
     {
         api::http::server::Response<> response;
-        io::Plexus<Request, Response, true>::emplace(response.init2());
+        io::Plexus<Request, Response, true>::emplace(response.init2(), _settings);
         methods()->io(std::move(request), std::move(response));
     }
 }
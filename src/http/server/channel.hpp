@@ -20,10 +20,13 @@ namespace dci::module::www::http::server
         , public io::Plexus<Request, Response, true>
     {
     public:
-        Channel(idl::net::stream::Channel<> netStreamChannel);
+        Channel(idl::net::stream::Channel<> netStreamChannel, api::http::server::Settings&& settings);
         ~Channel();
 
     public:
         void emitIo(api::http::server::Request<> request);
+
+    private:
+        api::http::server::Settings _settings;
     };
 }
@@ -0,0 +1,99 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "compressedCache.hpp"
+
+namespace dci::module::www::http::server
+{
+    namespace
+    {
+        class CompressedCacheInstance
+            : public CompressedCache
+            , public mm::heap::Allocable<CompressedCacheInstance>
+        {
+        };
+
+        std::unique_ptr<CompressedCacheInstance> p_instance{};
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::optional<Bytes> CompressedCache::get(Bytes&& source, compression::Coding coding)
+    {
+        std::string content = source.toString();
+        Key key{std::hash<std::string_view>{}(content), content.size(), coding};
+
+        if(auto iter = _index.find(key); _index.end() != iter)
+        {
+            _lru.splice(_lru.begin(), _lru, iter->second);
+
+            Bytes res;
+            res.end().write(iter->second->_compressed.data(), iter->second->_compressed.size());
+            return res;
+        }
+
+        compression::Compressor compressor;
+        if(!compression::setup(compressor, coding, true))
+            return {};
+
+        std::optional<Bytes> res = compressor.visit([&](auto& concrete)
+        {
+            return concrete.exec(std::move(source), true);
+        });
+
+        if(!res || res->size() > _capacity)
+            return res;
+
+        _lru.push_front(Entry{key, res->toString()});
+        _index.emplace(key, _lru.begin());
+        _size += _lru.front()._compressed.size();
+
+        while(_size > _capacity)
+        {
+            _size -= _lru.back()._compressed.size();
+            _index.erase(_lru.back()._key);
+            _lru.pop_back();
+        }
+
+        return res;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void CompressedCache::moduleStarted()
+    {
+        p_instance = std::make_unique<CompressedCacheInstance>();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    CompressedCache& CompressedCache::instance()
+    {
+        dbgAssert(p_instance);
+        return *p_instance;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void CompressedCache::moduleStopped()
+    {
+        p_instance.reset();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    CompressedCache::CompressedCache()
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    CompressedCache::~CompressedCache()
+    {
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::size_t CompressedCache::KeyHash::operator()(const Key& key) const
+    {
+        return key._hash ^ (key._size * 0x9e3779b97f4a7c15ull) ^ static_cast<std::size_t>(key._coding);
+    }
+}
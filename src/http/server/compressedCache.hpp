@@ -0,0 +1,62 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+#include "compression.hpp"
+
+namespace dci::module::www::http::server
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // compressed representations of bodies marked cacheable, made once at the strongest levels,
+    // keyed by content hash and coding, least recently used ones go first past the capacity
+    class CompressedCache
+    {
+    public:
+        static constexpr std::size_t _capacity = 64 * 1024 * 1024;
+        static constexpr std::size_t _maxSourceSize = 8 * 1024 * 1024;
+
+        std::optional<Bytes> get(Bytes&& source, compression::Coding coding);
+
+    public:
+        static void moduleStarted();
+        static CompressedCache& instance();
+        static void moduleStopped();
+
+    protected:
+        CompressedCache();
+        ~CompressedCache();
+
+    private:
+        struct Key
+        {
+            std::size_t         _hash;
+            std::size_t         _size;
+            compression::Coding _coding;
+
+            bool operator==(const Key&) const = default;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            Key         _key;
+            std::string _compressed;
+        };
+
+        using Lru = std::list<Entry>;
+
+        Lru                                             _lru;   // most recent first
+        std::unordered_map<Key, Lru::iterator, KeyHash> _index;
+        std::size_t                                     _size{};
+    };
+}
@@ -0,0 +1,181 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "compression.hpp"
+
+namespace dci::module::www::http::server::compression
+{
+    using namespace std::string_view_literals;
+
+    namespace
+    {
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        std::string_view trim(std::string_view s)
+        {
+            while(!s.empty() && (' ' == s.front() || '\t' == s.front()))
+                s.remove_prefix(1);
+            while(!s.empty() && (' ' == s.back() || '\t' == s.back()))
+                s.remove_suffix(1);
+            return s;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        bool iequals(std::string_view a, std::string_view b)
+        {
+            if(a.size() != b.size())
+                return false;
+
+            for(std::size_t i{}; i<a.size(); ++i)
+                if(std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+                    return false;
+
+            return true;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        bool istartsWith(std::string_view s, std::string_view prefix)
+        {
+            return s.size() >= prefix.size() && iequals(s.substr(0, prefix.size()), prefix);
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // "q=0", "q=0.", "q=0.000"
+        bool zeroQuality(std::string_view params)
+        {
+            while(!params.empty())
+            {
+                std::size_t semicolon = params.find(';');
+                std::string_view param = trim(params.substr(0, semicolon));
+                params = semicolon == std::string_view::npos ? std::string_view{} : params.substr(semicolon + 1);
+
+                if(param.size() < 2 || ('q' != param[0] && 'Q' != param[0]))
+                    continue;
+
+                param = trim(param.substr(1));
+                if(param.empty() || '=' != param[0])
+                    continue;
+
+                param = trim(param.substr(1));
+                if(param.empty() || '0' != param[0])
+                    return false;
+
+                for(char c : param.substr(1))
+                    if('.' != c && '0' != c)
+                        return false;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        constexpr Codings p_all = mask(Coding::zstd) | mask(Coding::br) | mask(Coding::gzip);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Codings accepted(std::string_view acceptEncoding)
+    {
+        Codings listed{};
+        Codings refused{};
+        bool any{};
+
+        while(!acceptEncoding.empty())
+        {
+            std::size_t comma = acceptEncoding.find(',');
+            std::string_view item = acceptEncoding.substr(0, comma);
+            acceptEncoding = comma == std::string_view::npos ? std::string_view{} : acceptEncoding.substr(comma + 1);
+
+            std::size_t semicolon = item.find(';');
+            std::string_view token = trim(item.substr(0, semicolon));
+            bool zero = std::string_view::npos != semicolon && zeroQuality(item.substr(semicolon + 1));
+
+            Codings codings{};
+            if(iequals(token, "zstd"sv))                                    codings = mask(Coding::zstd);
+            else if(iequals(token, "br"sv))                                 codings = mask(Coding::br);
+            else if(iequals(token, "gzip"sv) || iequals(token, "x-gzip"sv)) codings = mask(Coding::gzip);
+            else if("*"sv == token)                                         any = !zero;
+
+            (zero ? refused : listed) |= codings;
+        }
+
+        if(any)
+            listed |= p_all & ~refused;
+
+        return listed & ~refused;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Coding choose(Codings accepted)
+    {
+        for(Coding coding : {Coding::zstd, Coding::br, Coding::gzip})
+            if(accepted & mask(coding))
+                return coding;
+
+        return Coding::none;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::string_view name(Coding coding)
+    {
+        switch(coding)
+        {
+        case Coding::zstd:  return "zstd"sv;
+        case Coding::br:    return "br"sv;
+        case Coding::gzip:  return "gzip"sv;
+        default:            break;
+        }
+
+        return {};
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool compressible(std::string_view contentType)
+    {
+        contentType = trim(contentType.substr(0, contentType.find(';')));
+
+        if(istartsWith(contentType, "text/"sv))
+            return true;
+
+        static constexpr std::string_view compressed[] =
+        {
+            "image/"sv, "audio/"sv, "video/"sv, "font/woff"sv,
+            "application/zip"sv, "application/gzip"sv, "application/x-gzip"sv, "application/zstd"sv,
+            "application/x-brotli"sv, "application/x-7z-compressed"sv, "application/x-rar-compressed"sv,
+            "application/x-bzip2"sv, "application/x-xz"sv, "application/pdf"sv, "application/octet-stream"sv,
+        };
+
+        for(std::string_view prefix : compressed)
+        {
+            if(istartsWith(contentType, prefix))
+            {
+                // vector images are text
+                return iequals(contentType, "image/svg+xml"sv);
+            }
+        }
+
+        return !contentType.empty();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool setup(Compressor& compressor, Coding coding, bool cached)
+    {
+        switch(coding)
+        {
+        case Coding::zstd:
+            return compressor.emplace<compress::Zstd<compress::Direction::compress>>().initialize(cached ? _cachedZstdLevel : _zstdLevel);
+        case Coding::br:
+            return compressor.emplace<compress::Br<compress::Direction::compress>>().initialize(cached ? _cachedBrQuality : _brQuality);
+        case Coding::gzip:
+            return compressor.emplace<compress::Zlib<compress::zlib::Type::gzip, compress::Direction::compress>>().initialize(cached ? _cachedGzipLevel : _gzipLevel);
+        default:
+            break;
+        }
+
+        return compressor.emplace<compress::None>().initialize();
+    }
+}
@@ -0,0 +1,65 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+#include "../compress/none.hpp"
+#include "../compress/zlib.hpp"
+#include "../compress/br.hpp"
+#include "../compress/zstd.hpp"
+
+namespace dci::module::www::http::server::compression
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // in order of preference
+    enum class Coding : uint8
+    {
+        none,
+        zstd,
+        br,
+        gzip,
+    };
+
+    using Codings = uint8;
+
+    constexpr Codings mask(Coding coding)
+    {
+        return static_cast<Codings>(1u << static_cast<uint8>(coding));
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // codings listed in an Accept-Encoding value, those with q=0 are excluded
+    Codings accepted(std::string_view acceptEncoding);
+    Coding choose(Codings accepted);
+    std::string_view name(Coding coding);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // false for media which is compressed by itself
+    bool compressible(std::string_view contentType);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    using Compressor = Variant
+    <
+        compress::None,
+        compress::Zlib<compress::zlib::Type::gzip, compress::Direction::compress>,
+        compress::Br<compress::Direction::compress>,
+        compress::Zstd<compress::Direction::compress>
+    >;
+
+    // levels fit for on the fly compression
+    constexpr int _gzipLevel = 6;
+    constexpr int _brQuality = 5;
+    constexpr int _zstdLevel = 3;
+
+    // levels for representations made once and reused
+    constexpr int _cachedGzipLevel = 9;
+    constexpr int _cachedBrQuality = 11;
+    constexpr int _cachedZstdLevel = 19;
+
+    bool setup(Compressor& compressor, Coding coding, bool cached = false);
+}
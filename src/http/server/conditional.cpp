@@ -0,0 +1,91 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "conditional.hpp"
+#include "../httpDate.hpp"
+
+namespace dci::module::www::http::server::conditional
+{
+    namespace
+    {
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        // opaque-tag with quotes, the weakness prefix dropped
+        std::string_view opaque(std::string_view etag)
+        {
+            if(etag.starts_with("W/"))
+                etag.remove_prefix(2);
+            return etag;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        bool isEtagc(char c)
+        {
+            unsigned char uc = static_cast<unsigned char>(c);
+            return 0x21 == uc || (0x23 <= uc && 0x7e >= uc) || 0x80 <= uc;
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool validEtag(std::string_view etag)
+    {
+        etag = opaque(etag);
+        if(etag.size() < 2 || '"' != etag.front() || '"' != etag.back())
+            return false;
+
+        return std::all_of(etag.begin() + 1, etag.end() - 1, &isEtagc);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool noneMatch(std::string_view ifNoneMatch, std::string_view etag)
+    {
+        if(etag.empty())
+            return false;
+
+        std::string_view own = opaque(etag);
+
+        // commas are allowed inside the quotes, so tags are taken by the quotes rather than by the commas
+        std::size_t pos{};
+        while(pos < ifNoneMatch.size())
+        {
+            char c = ifNoneMatch[pos];
+            if(' ' == c || '\t' == c || ',' == c)
+            {
+                ++pos;
+                continue;
+            }
+
+            if('*' == c)
+                return true;
+
+            std::size_t begin = pos;
+            if(ifNoneMatch.substr(pos).starts_with("W/"))
+                pos += 2;
+
+            if(pos >= ifNoneMatch.size() || '"' != ifNoneMatch[pos])
+                return false;
+
+            std::size_t end = ifNoneMatch.find('"', pos + 1);
+            if(std::string_view::npos == end)
+                return false;
+
+            if(opaque(ifNoneMatch.substr(begin, end + 1 - begin)) == own)
+                return true;
+
+            pos = end + 1;
+        }
+
+        return false;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool notModifiedSince(std::string_view ifModifiedSince, uint64 lastModified)
+    {
+        std::optional<std::time_t> since = httpDate::parse(ifModifiedSince);
+        return since && 0 <= *since && lastModified <= static_cast<uint64>(*since);
+    }
+}
@@ -0,0 +1,25 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+
+namespace dci::module::www::http::server::conditional
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // entity-tag, quoted and optionally weak: "xyz" or W/"xyz"
+    bool validEtag(std::string_view etag);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // If-None-Match value lists the etag or is "*", by weak comparison
+    bool noneMatch(std::string_view ifNoneMatch, std::string_view etag);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // If-Modified-Since value is not older than lastModified, unparsable date never is
+    bool notModifiedSince(std::string_view ifModifiedSince, uint64 lastModified);
+}
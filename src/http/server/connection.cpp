@@ -0,0 +1,41 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "connection.hpp"
+#include "../../enumSupport.hpp"
+
+namespace dci::module::www::http::server::connection
+{
+    using namespace std::string_view_literals;
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    Options options(std::string_view connection)
+    {
+        Options res;
+
+        while(!connection.empty())
+        {
+            std::size_t comma = connection.find(',');
+            std::string_view token = connection.substr(0, comma);
+            connection = comma == std::string_view::npos ? std::string_view{} : connection.substr(comma + 1);
+
+            while(!token.empty() && (' ' == token.front() || '\t' == token.front()))
+                token.remove_prefix(1);
+            while(!token.empty() && (' ' == token.back() || '\t' == token.back()))
+                token.remove_suffix(1);
+
+            // tokens are case-insensitive, etalons are in lower case
+            if(enumSupport::ph::equal<true>(token, "close"sv))
+                res._close = true;
+            else if(enumSupport::ph::equal<true>(token, "keep-alive"sv))
+                res._keepAlive = true;
+        }
+
+        return res;
+    }
+}
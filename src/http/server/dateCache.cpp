@@ -0,0 +1,83 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "dateCache.hpp"
+#include "../httpDate.hpp"
+#include <ctime>
+
+namespace dci::module::www::http::server
+{
+    namespace
+    {
+        class DateCacheInstance
+            : public DateCache
+            , public mm::heap::Allocable<DateCacheInstance>
+        {
+        };
+
+        std::unique_ptr<DateCacheInstance> p_instance{};
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void DateCache::write(std::string& out)
+    {
+        if(!_fresh)
+            refresh();
+
+        out.append(_line.data(), _lineSize);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void DateCache::moduleStarted()
+    {
+        p_instance = std::make_unique<DateCacheInstance>();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    DateCache& DateCache::instance()
+    {
+        dbgAssert(p_instance);
+        return *p_instance;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void DateCache::moduleStopped()
+    {
+        p_instance.reset();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    DateCache::DateCache()
+    {
+        // the value goes stale a second after it was made; idle module keeps the timer stopped
+        _timer.tick() += _sol * [this]()
+        {
+            _fresh = false;
+        };
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    DateCache::~DateCache()
+    {
+        _sol.flush();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void DateCache::refresh()
+    {
+        char* pos = _line.data();
+        pos = std::copy_n("Date: ", 6, pos);
+        httpDate::format(std::time(nullptr), pos);
+        pos += httpDate::_size;
+        pos = std::copy_n("\r\n", 2, pos);
+        dbgAssert(pos == _line.data() + _lineSize);
+
+        _fresh = true;
+        _timer.start();
+    }
+}
@@ -0,0 +1,41 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+
+namespace dci::module::www::http::server
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // "Date: <IMF-fixdate>\r\n" shared by all responses of the module, formatted at most once per second
+    class DateCache
+    {
+    public:
+        static constexpr std::size_t _lineSize = 37;
+
+        void write(std::string& out);
+
+    public:
+        static void moduleStarted();
+        static DateCache& instance();
+        static void moduleStopped();
+
+    protected:
+        DateCache();
+        ~DateCache();
+
+    private:
+        void refresh();
+
+    private:
+        std::array<char, _lineSize> _line{};
+        bool                        _fresh{};
+        poll::Timer                 _timer{std::chrono::milliseconds{1000}};
+        sbs::Owner                  _sol;
+    };
+}
@@ -0,0 +1,137 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "range.hpp"
+#include "../httpDate.hpp"
+#include <random>
+
+namespace dci::module::www::http::server::range
+{
+    namespace
+    {
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        std::string_view trimmed(std::string_view str)
+        {
+            while(!str.empty() && (' ' == str.front() || '\t' == str.front()))
+                str.remove_prefix(1);
+            while(!str.empty() && (' ' == str.back() || '\t' == str.back()))
+                str.remove_suffix(1);
+            return str;
+        }
+
+        /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+        std::optional<uint64> number(std::string_view str)
+        {
+            uint64 value{};
+            const char* end = str.data() + str.size();
+            auto [prsEnd, ec] = std::from_chars(str.data(), end, value);
+            if(str.empty() || std::errc{} != ec || end != prsEnd)
+                return {};
+            return value;
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::optional<Spans> parse(std::string_view range, uint64 size)
+    {
+        range = trimmed(range);
+        if(range.size() < 6 || !std::equal(range.begin(), range.begin() + 6, "bytes=", [](char a, char b){return std::tolower(static_cast<unsigned char>(a)) == b;}))
+            return {};
+        range.remove_prefix(6);
+
+        Spans spans;
+        std::size_t specs{};
+        while(!range.empty())
+        {
+            std::size_t comma = range.find(',');
+            std::string_view spec = trimmed(range.substr(0, comma));
+            range = std::string_view::npos == comma ? std::string_view{} : range.substr(comma + 1);
+
+            // empty list elements are allowed
+            if(spec.empty())
+                continue;
+
+            if(++specs > _maxSpans)
+                return {};
+
+            std::size_t dash = spec.find('-');
+            if(std::string_view::npos == dash)
+                return {};
+
+            std::string_view firstStr = spec.substr(0, dash);
+            std::string_view lastStr = spec.substr(dash + 1);
+
+            if(firstStr.empty())
+            {
+                // suffix
+                std::optional<uint64> suffix = number(lastStr);
+                if(!suffix)
+                    return {};
+                if(*suffix && size)
+                    spans.push_back(Span{size - std::min(*suffix, size), size - 1});
+                continue;
+            }
+
+            std::optional<uint64> first = number(firstStr);
+            std::optional<uint64> last = lastStr.empty() ? std::optional<uint64>{~uint64{}} : number(lastStr);
+            if(!first || !last || *last < *first)
+                return {};
+
+            if(*first < size)
+                spans.push_back(Span{*first, std::min(*last, size - 1)});
+        }
+
+        if(!specs)
+            return {};
+
+        // the body streams in order once, so the parts are ascending; overlapping and adjacent ones are coalesced
+        std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b){return a._first < b._first;});
+
+        Spans res;
+        for(const Span& span : spans)
+        {
+            if(!res.empty() && span._first <= res.back()._last + 1)
+                res.back()._last = std::max(res.back()._last, span._last);
+            else
+                res.push_back(span);
+        }
+
+        return res;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool ifRangeMatch(std::string_view ifRange, std::string_view etag, uint64 lastModified)
+    {
+        ifRange = trimmed(ifRange);
+
+        // entity-tag, compared strongly
+        if(ifRange.starts_with("W/"))
+            return false;
+        if(ifRange.starts_with('"'))
+            return !etag.empty() && !etag.starts_with("W/") && ifRange == etag;
+
+        std::optional<std::time_t> date = httpDate::parse(ifRange);
+        return date && lastModified && static_cast<uint64>(*date) == lastModified;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    std::string boundary()
+    {
+        static std::mt19937_64 generator{std::random_device{}()};
+
+        char res[16];
+        std::uint64_t value = generator();
+        for(char& c : res)
+        {
+            c = "0123456789abcdef"[value & 0x0f];
+            value >>= 4;
+        }
+
+        return std::string{res, sizeof(res)};
+    }
+}
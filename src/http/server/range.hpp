@@ -0,0 +1,39 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+
+namespace dci::module::www::http::server::range
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // inclusive positions in the representation
+    struct Span
+    {
+        uint64 _first;
+        uint64 _last;
+    };
+
+    using Spans = std::vector<Span>;
+
+    // more ranges than that are not served by parts, the whole representation goes instead
+    constexpr std::size_t _maxSpans = 16;
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // Range value against the representation size: ascending non-overlapping spans, empty when none is satisfiable;
+    // nothing when the field is to be ignored
+    std::optional<Spans> parse(std::string_view range, uint64 size);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // If-Range value is the strong etag or the exact modification time of the representation
+    bool ifRangeMatch(std::string_view ifRange, std::string_view etag, uint64 lastModified);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // multipart/byteranges delimiter, not expected to occur in a body
+    std::string boundary();
+}
@@ -29,34 +29,127 @@ namespace dci::module::www::http::server
     void Request::setResponse(Response* response)
     {
         _response = response;
+
+        if(_last)
+            _response->lastRequest();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::limitHead(std::chrono::milliseconds timeout)
+    {
+        dbgAssert(timeout.count());
+        _headTimer.emplace(timeout);
+        _headTimer->tick() += _sol * [this]()
+        {
+            fail(inputSlicer::Result::timeout);
+        };
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::limitBodyRate(uint32 bytesPerSecond, std::chrono::milliseconds window)
+    {
+        dbgAssert(bytesPerSecond && window.count());
+        _bodyRateMin = static_cast<uint64>(bytesPerSecond) * static_cast<uint64>(window.count()) / 1000;
+        _bodyRateTimer.emplace(window);
+        _bodyRateTimer->tick() += _sol * [this]()
+        {
+            // a body held by the server itself is not the client's fault
+            if(!_bodyWaits && _held.empty() && !_support->outputPaused() && _bodyRateBytes < _bodyRateMin)
+            {
+                fail(inputSlicer::Result::timeout);
+                return;
+            }
+
+            _bodyRateBytes = 0;
+            _bodyRateTimer->start();
+        };
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::limitBodyCredit(uint32 window)
+    {
+        _bodyWindow = window;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::limitRequests(uint32 maxRequests)
+    {
+        dbgAssert(maxRequests);
+        _maxRequests = maxRequests;
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     io::InputProcessResult Request::process(bytes::Alter& data)
     {
+        // nothing is dispatched after the last request, the data is left unread
+        if(_exhausted)
+            return io::InputProcessResult::wait;
+
+        // body held for credits goes before anything new is read
+        if(!_held.empty())
+        {
+            deliverHeld();
+            if(!_held.empty())
+                return io::InputProcessResult::wait;
+        }
+
+        if(std::exchange(_heldDone, false))
+            return complete();
+
+        // resumed with nothing new
+        if(data.atEnd())
+            return io::InputProcessResult::needMore;
+
         inputSlicer::Result inputSlicerResult;
         {
             inputSlicer::SourceAdapter sa{data};
             inputSlicerResult = IS::process(sa);
         }
 
-        ExceptionPtr err4Fail;
         switch(inputSlicerResult)
         {
         case inputSlicer::Result::needMore:
             dbgAssert(data.atBegin() && data.atEnd());
             return io::InputProcessResult::needMore;
 
+        case inputSlicer::Result::wait:
+            return io::InputProcessResult::wait;
+
         case inputSlicer::Result::done:
-            _response = nullptr;
-            reset();
-            if(_api)
-            {
-                _api->done();
-                _api.reset();
-            }
-            return io::InputProcessResult::done;
+            return complete();
+
+        default:
+            break;
+        }
 
+        fail(inputSlicerResult);
+        return io::InputProcessResult::bad;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    io::InputProcessResult Request::complete()
+    {
+        if(_bodyRateTimer)
+            _bodyRateTimer->stop();
+        _response = nullptr;
+        _bodyWaits = false;
+        _skipBody = false;
+        _exhausted = _last;
+        reset();
+        if(_api)
+        {
+            _api->done();
+            _api.reset();
+        }
+        return io::InputProcessResult::done;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::fail(inputSlicer::Result inputSlicerResult)
+    {
+        ExceptionPtr err4Fail;
+        switch(inputSlicerResult)
+        {
         case inputSlicer::Result::internalError:
             err4Fail = exception::buildInstance<api::http::error::request::InternalServerError>();
             break;
@@ -89,22 +182,47 @@ namespace dci::module::www::http::server
             err4Fail = exception::buildInstance<api::http::error::request::UnprocessableContent>();
             break;
 
+        case inputSlicer::Result::timeout:
+            err4Fail = exception::buildInstance<api::http::error::request::Timeout>();
+            break;
+
         default:
             unreacheable();
             break;
         }
 
-        _response->requestFailed(inputSlicerResult);
-        _support->failed(this, std::move(err4Fail));
+        if(_headTimer)
+            _headTimer->stop();
+        if(_bodyRateTimer)
+            _bodyRateTimer->stop();
 
-        return io::InputProcessResult::bad;
+        _held.clear();
+        _heldDone = false;
+
+        if(_response)
+            _response->requestFailed(inputSlicerResult);
+        _support->failed(this, std::move(err4Fail));
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     inputSlicer::Result Request::sliceStart()
     {
+        if(_headTimer)
+            _headTimer->start();
+
+        _last = ++_requests >= _maxRequests;
+
+        _credit = _bodyWindow;
+
         api::http::server::Request<> api;
         Base::setApi(api.init2());
+
+        // in grant(uint64 size);
+        _api.methods()->grant() += _sol * [this](uint64 size)
+        {
+            grant(size);
+        };
+
         static_cast<Channel*>(_support)->emitIo(std::move(api));
 
         return inputSlicer::Result::done;
@@ -113,30 +231,144 @@ namespace dci::module::www::http::server
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     inputSlicer::Result Request::sliceFlush(inputSlicer::state::RequestFirstLine& firstLine)
     {
-        //std::cout << "[" << firstLine._method <<"][" << firstLine._uri << "][" << firstLine._version << "]" << std::endl;
-        _api->firstLine(*firstLine._parsedMethod, std::move(firstLine._uri._downstream), *firstLine._parsedVersion);
+        _http11 = api::http::firstLine::Version::HTTP_1_1 == *firstLine._parsedVersion;
+        _response->request(*firstLine._parsedMethod, *firstLine._parsedVersion);
+        _api->firstLine(*firstLine._parsedMethod, String{firstLine._uri.str()}, *firstLine._parsedVersion);
         return IS::sliceFlush(firstLine);
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     inputSlicer::Result Request::sliceFlush(inputSlicer::state::Headers& headers, bool done)
     {
-        // if(header._empty)
-        //     std::cout << "[" << header._key <<"][" << header._value << "]" << std::endl;
-        // else
-        //     std::cout << "[" << header._key <<"][" << header._value << "]" << std::endl;
+        primitives::List<api::http::Header> some = headers._conveyor.detachSome();
 
-        _api->headers(headers._conveyor.detachSome(), done);
+        for(const api::http::Header& header : some)
+            if(header.key.holds<api::http::header::KeyRecognized>())
+                _response->requestHeader(header.key.get<api::http::header::KeyRecognized>(), header.value);
+
+        if(done)
+        {
+            if(_headTimer)
+                _headTimer->stop();
+
+            if(_bodyRateTimer)
+            {
+                _bodyRateBytes = 0;
+                _bodyRateTimer->start();
+            }
+
+            if(!_response->persistent())
+                _last = true;
+        }
+
+        _api->headers(std::move(some), done);
         return IS::sliceFlush(headers, done);
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     inputSlicer::Result Request::sliceFlush(inputSlicer::state::Body& body, bool done)
     {
-        // std::cout << "some body" << std::endl;
+        _bodyRateBytes += body._content.size();
 
-        _api->data(std::exchange(body._content, {}), done);
+        // rejected body is consumed to keep the connection, but goes nowhere
+        if(_skipBody)
+            body._content.clear();
+        else if(!_bodyWindow || (_held.empty() && body._content.size() <= _credit))
+        {
+            if(_bodyWindow)
+                _credit -= body._content.size();
+            _api->data(std::exchange(body._content, {}), done);
+        }
+        else
+        {
+            // beyond the credit, reading stops until the application grants more
+            _held.end().write(std::exchange(body._content, {}));
+            _heldDone = done;
+            deliverHeld();
+
+            if(!_held.empty())
+                return inputSlicer::Result::wait;
+            _heldDone = false;
+        }
 
         return IS::sliceFlush(body, done);
     }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::deliverHeld()
+    {
+        // application may grant right from data(), the loop below takes it
+        if(_delivering)
+            return;
+
+        _delivering = true;
+        while(_api && !_held.empty() && _credit)
+        {
+            Bytes part;
+            if(_held.size() <= _credit)
+                part = std::exchange(_held, {});
+            else
+            {
+                bytes::Alter alter{_held.begin()};
+                alter.removeTo(part, static_cast<uint32>(std::min<uint64>(_credit, ~uint32{})));
+            }
+
+            _credit -= part.size();
+            _api->data(std::move(part), _heldDone && _held.empty());
+        }
+        _delivering = false;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::grant(uint64 size)
+    {
+        if(!_bodyWindow)
+            return;
+
+        _credit += size;
+        if(_held.empty() || _delivering)
+            return;
+
+        deliverHeld();
+        if(_held.empty())
+            _support->resumeInput();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    inputSlicer::Result Request::sliceExpectContinue()
+    {
+        // HTTP/1.0 clients do not wait for 100 Continue
+        if(!_http11)
+            return inputSlicer::Result::needMore;
+
+        _bodyWaits = true;
+        _askingBody = true;
+        _response->expectContinue();
+        _askingBody = false;
+
+        return _bodyWaits ? inputSlicer::Result::wait : inputSlicer::Result::needMore;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Request::decideBody(BodyDecision decision)
+    {
+        if(!_bodyWaits)
+            return;
+
+        switch(decision)
+        {
+        case BodyDecision::accept:
+            break;
+        case BodyDecision::skip:
+            _skipBody = true;
+            break;
+        case BodyDecision::close:
+            // never read, the connection closes after the response
+            return;
+        }
+
+        _bodyWaits = false;
+        if(!_askingBody)
+            _support->resumeInput();
+    }
 }
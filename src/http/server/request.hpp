@@ -16,6 +16,7 @@ namespace dci::module::www::http::server
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     class Response;
+    enum class BodyDecision;
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     class Request
@@ -33,14 +34,55 @@ namespace dci::module::www::http::server
         void setResponse(Response* response);
         io::InputProcessResult process(bytes::Alter& data);
 
+        using IS::setLimits;
+        using IS::arena;
+        void limitHead(std::chrono::milliseconds timeout);
+        void limitRequests(uint32 maxRequests);
+        void limitBodyRate(uint32 bytesPerSecond, std::chrono::milliseconds window);
+        void limitBodyCredit(uint32 window);
+
+        // body held by Expect: 100-continue
+        void decideBody(BodyDecision decision);
+
+    private:
+        io::InputProcessResult complete();
+        void fail(inputSlicer::Result inputSlicerResult);
+        void deliverHeld();
+        void grant(uint64 size);
+
     private:
         friend IS;
         inputSlicer::Result sliceStart();
         inputSlicer::Result sliceFlush(inputSlicer::state::RequestFirstLine& firstLine);
         inputSlicer::Result sliceFlush(inputSlicer::state::Headers& headers, bool done);
         inputSlicer::Result sliceFlush(inputSlicer::state::Body& body, bool done);
+        inputSlicer::Result sliceExpectContinue();
 
     private:
         Response* _response{};
+
+        bool _http11{};
+        bool _bodyWaits{};
+        bool _askingBody{};
+        bool _skipBody{};
+
+        // keep-alive policy, the connection closes once the last request and its response are done
+        std::optional<poll::Timer>  _headTimer;
+        uint32                      _maxRequests{~uint32{}};
+        uint32                      _requests{};
+        bool                        _last{};
+        bool                        _exhausted{};
+
+        // slow body senders, at least _bodyRateMin bytes are expected in each window
+        std::optional<poll::Timer>  _bodyRateTimer;
+        uint64                      _bodyRateMin{};
+        uint64                      _bodyRateBytes{};
+
+        // body flow control, no more than the application granted is delivered and the rest stays unread
+        uint64                      _bodyWindow{};
+        uint64                      _credit{};
+        Bytes                       _held;
+        bool                        _heldDone{};
+        bool                        _delivering{};
     };
 }
@@ -8,87 +8,258 @@
 #include "pch.hpp"
 #include "response.hpp"
 #include "request.hpp"
-#include "../../enumSupport.hpp"
+#include "dateCache.hpp"
+#include "compression.hpp"
+#include "compressedCache.hpp"
+#include "conditional.hpp"
+#include "range.hpp"
+#include "connection.hpp"
+#include "../serializer.hpp"
+#include "../httpDate.hpp"
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace dci::module::www::http::server
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-    Response::Response(Support* support, api::http::server::Response<>::Opposite&& api)
+    Response::Response(Support* support, api::http::server::Response<>::Opposite&& api, const api::http::server::Settings& settings)
         : Base{support, std::move(api)}
+        , _addDate{settings.addDate}
+        , _deferContinue{settings.deferContinue}
+        , _compress{settings.compress}
+        , _compressMinSize{settings.compressMinSize}
     {
-        // in firstLine(firstLine::Method, string path, firstLine::Version);
-        _api.methods()->firstLine() += _sol * [this](api::http::firstLine::Version /*version*/, api::http::firstLine::StatusCode /*statusCode*/, primitives::String&& /*statusText*/)
-        {
-            dbgFatal("not impl");
-            // bytes::Alter out{_buffer.end()};
-
-            // std::optional<std::string_view> optStr = enumSupport::toString(version);
-            // if(!optStr)
-            // {
-            //     _support->_failed.in(exception::buildInstance<api::http::error::UnknownRequestMethod>());
-            //     _support->close();
-            //     return;
-            // }
-            // out.write(optStr->data(), optStr->size());
-
-            // out.write(" ");
-            // std::string statusCodeStr = std::to_string(statusCode);
-            // out.write(statusCodeStr.data(), statusCodeStr.size());
-            // out.write(" ");
-            // out.write(statusText.data(), statusText.size());
-            // out.write("\r\n");
+        _pumpTimer.tick() += _sol * [this]()
+        {
+            pump();
+        };
+
+        // a pause and resume within one turn tell nothing
+        _pressureTimer.tick() += _sol * [this]()
+        {
+            bool paused = _support->outputPaused();
+            if(!_api || paused == _apiPaused)
+                return;
+
+            _apiPaused = paused;
+            if(paused)
+                _api->paused();
+            else
+                _api->resumed();
+        };
+
+        // in firstLine(firstLine::Version, firstLine::StatusCode, string statusText);
+        _api.methods()->firstLine() += _sol * [this](api::http::firstLine::Version version, api::http::firstLine::StatusCode statusCode, primitives::String&& statusText)
+        {
+            if(_notModified)
+                return;
+
+            // final response made before the body is accepted refuses it
+            if(_deferContinue && statusCode >= 200)
+                decideBody(BodyDecision::close);
+
+            _version = version;
+            _http11 = api::http::firstLine::Version::HTTP_1_1 == version;
+            _statusCode = statusCode;
+
+            _head.reserve(_headReserve);
+            serialized(serializer::responseFirstLine(_head, version, statusCode, statusText));
+            _firstLineSize = _head.size();
         };
 
         // in headers(list<Header>, bool done);
-        _api.methods()->headers() += _sol * [this](const primitives::List<api::http::Header>& /*headers*/, bool /*done*/)
-        {
-            dbgFatal("not impl");
-            // {
-            //     bytes::Alter out{_buffer.end()};
-
-            //     for(const api::http::Header& header : headers)
-            //     {
-            //         header.key.visit([&]<class K>(const K& value)
-            //         {
-            //             if constexpr(std::is_same_v<api::http::header::KeyRecognized, K>)
-            //             {
-            //                 std::optional<std::string_view> optStr = enumSupport::toString(value);
-            //                 if(!optStr)
-            //                 {
-            //                     _support->_failed.in(exception::buildInstance<api::http::error::UnknownRequestVersion>());
-            //                     _support->close();
-            //                     return;
-            //                 }
-            //                 out.write(optStr->data(), optStr->size());
-            //             }
-            //             else
-            //                 out.write(value.data(), value.size());
-            //         });
-
-            //         out.write(": ");
-            //         out.write(header.value.data(), header.value.size());
-            //         out.write("\r\n");
-            //     }
-
-            //     if(done)
-            //         out.write("\r\n");
-            // }
-
-            // flushBuffer();
+        _api.methods()->headers() += _sol * [this](const primitives::List<api::http::Header>& headers, bool done)
+        {
+            if(_notModified)
+                return;
+
+            for(const api::http::Header& header : headers)
+                if(header.key.holds<api::http::header::KeyRecognized>())
+                    inspect(header.key.get<api::http::header::KeyRecognized>(), header.value);
+
+            // the length is known only after the body coding and ranges are chosen, the type changes for multiple ranges
+            static constexpr api::http::header::KeyRecognized lengthAndType[] =
+            {
+                api::http::header::KeyRecognized::Content_Length,
+                api::http::header::KeyRecognized::Content_Type,
+            };
+
+            std::span<const api::http::header::KeyRecognized> deferred;
+            if(rangeCandidate())
+                deferred = lengthAndType;
+            else if(_compress)
+                deferred = std::span{lengthAndType}.first(1);
+
+            if(!serialized(serializer::headers(_head, headers, false, deferred)))
+                return;
+
+            if(done)
+            {
+                if(!finishHead())
+                    return;
+
+                flushHead();
+                flushBuffer();
+            }
         };
 
         // in data(bytes, bool done);
-        _api.methods()->data() += _sol * [this](Bytes data, bool /*done*/)
+        _api.methods()->data() += _sol * [this](Bytes data, bool done)
         {
-            _buffer.end().write(std::move(data));
+            if(_notModified)
+                return;
+
+            flushHead();
+
+            // selected parts queue up, the order of the pieces is kept by the pending list
+            if(_ranged)
+            {
+                bytes::Alter alter{data.begin()};
+                uint64 taken{};
+                selectRanges(data.size(),
+                    [this](std::string&& framing){pendFraming(framing);},
+                    [&](uint64 skip, uint64 count)
+                    {
+                        alter.remove(static_cast<uint32>(skip - taken));
+                        Bytes part;
+                        alter.removeTo(part, static_cast<uint32>(count));
+                        taken = skip + count;
+                        _pending.push_back(Pending{-1, 0, 0, std::move(part), false});
+                    });
+                pump();
+                return;
+            }
+
+            // goes after the files still being read
+            if(!_pending.empty())
+            {
+                _pending.push_back(Pending{-1, 0, 0, std::move(data), done});
+                pump();
+                return;
+            }
+
+            if(!writeBody(std::move(data), done))
+                return;
+
             flushBuffer();
         };
 
+        // in file(int32 fd, uint64 offset, uint64 size, bool done);
+        _api.methods()->file() += _sol * [this](int32 fd, uint64 offset, uint64 size, bool done)
+        {
+            if(_notModified)
+                return;
+
+            flushHead();
+
+            auto own = [&]
+            {
+                int res = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+                if(0 > res)
+                {
+                    LOGD("file body: " << std::strerror(errno));
+                    _support->close(exception::buildInstance<api::http::error::response::BadResponse>());
+                }
+                return res;
+            };
+
+            // only the selected parts of the file are read
+            if(_ranged)
+            {
+                bool failed{};
+                selectRanges(size,
+                    [this](std::string&& framing){pendFraming(framing);},
+                    [&](uint64 skip, uint64 count)
+                    {
+                        int fdPart = failed ? -1 : own();
+                        failed = 0 > fdPart;
+                        if(!failed)
+                            _pending.push_back(Pending{fdPart, offset + skip, count, {}, false});
+                    });
+
+                if(!failed)
+                    pump();
+                return;
+            }
+
+            int fdOwn = own();
+            if(0 > fdOwn)
+                return;
+
+            _pending.push_back(Pending{fdOwn, offset, size, {}, done});
+            pump();
+        };
+
+        // in cacheable();
+        _api.methods()->cacheable() += _sol * [this]()
+        {
+            _cacheable = true;
+        };
+
+        // in ranges();
+        _api.methods()->ranges() += _sol * [this]()
+        {
+            _acceptRanges = true;
+        };
+
+        // in validators(string etag, uint64 lastModified);
+        _api.methods()->validators() += _sol * [this](primitives::String&& etag, uint64 lastModified)
+        {
+            if(_notModified)
+                return;
+
+            if(!etag.empty() && !conditional::validEtag(etag))
+            {
+                serialized(serializer::Result::badHeader);
+                return;
+            }
+
+            // the fast path is open while nothing of the head is made
+            if(_head.empty() && !_statusCode && notModified(etag, lastModified))
+            {
+                _notModified = true;
+                _api->notModified();
+                return;
+            }
+
+            _etag = std::move(etag);
+            _lastModified = lastModified;
+        };
+
+        // in continueBody();
+        _api.methods()->continueBody() += _sol * [this]()
+        {
+            decideBody(BodyDecision::accept);
+        };
+
+        // in rejectBody(bool keepConnection);
+        _api.methods()->rejectBody() += _sol * [this](bool keepConnection)
+        {
+            decideBody(keepConnection ? BodyDecision::skip : BodyDecision::close);
+        };
+
         // in done();
         _api.methods()->done() += _sol * [this]()
         {
+            if(_notModified)
+            {
+                finish();
+                return;
+            }
+
+            flushHead();
+
+            if(!_pending.empty())
+            {
+                _doneAfterPending = true;
+                return;
+            }
+
+            if(_chunked && !writeChunked(Bytes{}, true))
+                return;
+
             flushBuffer();
-            apiDone();
+            finish();
         };
     }
 
@@ -96,6 +267,10 @@ namespace dci::module::www::http::server
     Response::~Response()
     {
         _sol.flush();
+
+        for(Pending& pending : _pending)
+            if(0 <= pending._fd)
+                ::close(pending._fd);
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -131,9 +306,692 @@ namespace dci::module::www::http::server
         case inputSlicer::Result::unprocessableContent:
             _buffer = "HTTP/1.1 422 Unprocessable Content\r\nConnection: close\r\n\r\n";
             break;
+        case inputSlicer::Result::timeout:
+            _buffer = "HTTP/1.1 408 Request Timeout\r\nConnection: close\r\n\r\n";
+            break;
+        }
+
+        flushBuffer();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::request(api::http::firstLine::Method method, api::http::firstLine::Version version)
+    {
+        _requestHttp10 = api::http::firstLine::Version::HTTP_1_0 == version;
+        _headRequest = api::http::firstLine::Method::HEAD == method;
+        _safeRequest = _headRequest || api::http::firstLine::Method::GET == method;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::requestHeader(api::http::header::KeyRecognized key, std::string_view value)
+    {
+        switch(key)
+        {
+        case api::http::header::KeyRecognized::Accept_Encoding:
+            _acceptedCodings |= compression::accepted(value);
+            break;
+        case api::http::header::KeyRecognized::If_None_Match:
+            // repeated field is the same as one with the values joined by commas
+            if(_ifNoneMatch)
+                *_ifNoneMatch += ",";
+            else
+                _ifNoneMatch.emplace();
+            *_ifNoneMatch += value;
+            break;
+        case api::http::header::KeyRecognized::If_Modified_Since:
+            _ifModifiedSince = value;
+            break;
+        case api::http::header::KeyRecognized::Range:
+            _range = value;
+            break;
+        case api::http::header::KeyRecognized::If_Range:
+            _ifRange = value;
+            break;
+        case api::http::header::KeyRecognized::Connection:
+            {
+                connection::Options options = connection::options(value);
+                _requestClose |= options._close;
+                _requestKeepAlive |= options._keepAlive;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::expectContinue()
+    {
+        _expectContinue = true;
+
+        // not asked, the body is welcome
+        if(!_deferContinue && !_bodyDecision)
+            _bodyDecision = BodyDecision::accept;
+
+        if(_bodyDecision)
+            applyBodyDecision();
+        else if(_api)
+            _api->expectContinue();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::lastRequest()
+    {
+        _lastRequest = true;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::persistent() const
+    {
+        if(_lastRequest || _requestClose)
+            return false;
+
+        return !_requestHttp10 || _requestKeepAlive;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::decideBody(BodyDecision decision)
+    {
+        if(_bodyDecision)
+            return;
+
+        _bodyDecision = decision;
+        if(_expectContinue)
+            applyBodyDecision();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::applyBodyDecision()
+    {
+        dbgAssert(_expectContinue && _bodyDecision);
+
+        switch(*_bodyDecision)
+        {
+        case BodyDecision::accept:
+            // interim response goes only ahead of the final one
+            if(!_statusCode)
+            {
+                _buffer.end().write("HTTP/1.1 100 Continue\r\n\r\n");
+                flushBuffer();
+            }
+            break;
+        case BodyDecision::skip:
+            break;
+        case BodyDecision::close:
+            _closeAfter = true;
+            break;
+        }
+
+        _support->input().decideBody(*_bodyDecision);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::finish()
+    {
+        // the unread body makes the connection unusable for the next request
+        if(_closeAfter)
+            fail();
+        else
+            apiDone();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::serialized(serializer::Result result)
+    {
+        switch(result)
+        {
+        case serializer::Result::ok:
+            return true;
+        case serializer::Result::badVersion:
+            _support->close(exception::buildInstance<api::http::error::response::BadVersion>());
+            break;
+        case serializer::Result::badStatus:
+            _support->close(exception::buildInstance<api::http::error::response::BadStatus>());
+            break;
+        default:
+            _support->close(exception::buildInstance<api::http::error::response::BadResponse>());
+            break;
+        }
+
+        return false;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::inspect(api::http::header::KeyRecognized key, std::string_view value)
+    {
+        switch(key)
+        {
+        case api::http::header::KeyRecognized::Date:
+            _addDate = false;
+            break;
+        case api::http::header::KeyRecognized::Content_Length:
+            _contentLength = value;
+            break;
+        case api::http::header::KeyRecognized::Content_Type:
+            _compressibleType = compression::compressible(value);
+            _contentType = value;
+            break;
+        case api::http::header::KeyRecognized::Content_Encoding:
+            _hasContentEncoding = true;
+            break;
+        case api::http::header::KeyRecognized::Transfer_Encoding:
+            _hasTransferEncoding = true;
+            break;
+        case api::http::header::KeyRecognized::Vary:
+            _hasVary = true;
+            break;
+        case api::http::header::KeyRecognized::Connection:
+            _hasConnection = true;
+            _closeAfter |= connection::options(value)._close;
+            break;
+        case api::http::header::KeyRecognized::ETag:
+            _hasEtag = true;
+            _etag = value;
+            break;
+        case api::http::header::KeyRecognized::Last_Modified:
+            _hasLastModified = true;
+            if(std::optional<std::time_t> date = httpDate::parse(value))
+                _lastModified = static_cast<uint64>(*date);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::finishHead()
+    {
+        if(_addDate)
+            DateCache::instance().write(_head);
+
+        if(!_etag.empty() && !_hasEtag)
+        {
+            _head += "ETag: ";
+            _head += _etag;
+            _head += "\r\n";
+        }
+
+        if(_lastModified && !_hasLastModified)
+        {
+            char date[httpDate::_size];
+            httpDate::format(static_cast<std::time_t>(_lastModified), date);
+            _head += "Last-Modified: ";
+            _head.append(date, httpDate::_size);
+            _head += "\r\n";
+        }
+
+        if(_acceptRanges && 200 == _statusCode)
+            _head += "Accept-Ranges: bytes\r\n";
+
+        // the status changes if a range is served
+        bool rangeRequested = rangeCandidate();
+
+        std::optional<uint64> contentLength;
+        if(_contentLength && (_compress || rangeRequested))
+        {
+            uint64 value{};
+            const char* end = _contentLength->data() + _contentLength->size();
+            auto [prsEnd, ec] = std::from_chars(_contentLength->data(), end, value);
+            if(_contentLength->empty() || std::errc{} != ec || end != prsEnd)
+                return serialized(serializer::Result::badHeader);
+            contentLength = value;
+        }
+
+        if(rangeRequested && contentLength && !_hasContentEncoding && !_hasTransferEncoding &&
+           (!_ifRange || range::ifRangeMatch(*_ifRange, _etag, _lastModified)))
+        {
+            std::optional<range::Spans> spans = range::parse(*_range, *contentLength);
+            if(spans)
+                rangedHead(std::move(*spans), *contentLength);
+        }
+
+        if(rangeRequested && !_ranged && _contentType)
+        {
+            _head += "Content-Type: ";
+            _head += *_contentType;
+            _head += "\r\n";
         }
 
+        if(_compress && !_ranged)
+        {
+            bool eligible =
+                hasBody() && 206 != _statusCode &&
+                !_hasContentEncoding && !_hasTransferEncoding && _compressibleType &&
+                (!contentLength || *contentLength >= _compressMinSize);
+
+            if(eligible)
+            {
+                if(!_hasVary)
+                    _head += "Vary: Accept-Encoding\r\n";
+
+                compression::Coding coding = compression::choose(_acceptedCodings);
+
+                // body length changes, chunked framing keeps the connection reusable,
+                // an HTTP/1.0 client cannot decode chunks and gets the identity body
+                if(_http11 && !_requestHttp10 && compression::Coding::none != coding && compression::setup(_compressor, coding))
+                {
+                    _head += "Content-Encoding: ";
+                    _head += compression::name(coding);
+                    _head += "\r\nTransfer-Encoding: chunked\r\n";
+                    _chunked = true;
+                    _coding = coding;
+                    _collecting = _cacheable;
+                }
+            }
+        }
+
+        if(contentLength && !_chunked && !_ranged)
+        {
+            _head += "Content-Length: ";
+            _head += *_contentLength;
+            _head += "\r\n";
+        }
+
+        // streamed body of unknown length, framed by chunks instead of the connection close,
+        // an HTTP/1.0 client cannot decode chunks and gets the body until the close
+        if(!_chunked && !_contentLength && !_hasTransferEncoding && _http11 && !_requestHttp10 && hasBody())
+        {
+            _head += "Transfer-Encoding: chunked\r\n";
+            _chunked = true;
+        }
+
+        connectionHead(_chunked || _ranged || _contentLength || _hasTransferEncoding || !hasBody(), !_http11);
+
+        _contentLength.reset();
+        _contentType.reset();
+        _head += "\r\n";
+        return true;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::connectionHead(bool delimited, bool http10)
+    {
+        // a body ended by the close leaves nothing to reuse
+        if(!delimited || !persistent())
+            _closeAfter = true;
+
+        if(_hasConnection)
+            return;
+
+        if(_closeAfter)
+            _head += "Connection: close\r\n";
+        else if(http10 || _requestHttp10)
+            _head += "Connection: keep-alive\r\n";
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::rangeCandidate() const
+    {
+        // Range is defined for GET only
+        return _acceptRanges && _range && _safeRequest && !_headRequest && 200 == _statusCode;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::rangedHead(range::Spans&& spans, uint64 size)
+    {
+        _ranged = true;
+        _spans = std::move(spans);
+
+        auto statusLine = [&](api::http::firstLine::StatusCode statusCode)
+        {
+            std::string line;
+            serializer::responseFirstLine(line, _version, statusCode, {});
+            _head.replace(0, _firstLineSize, line);
+            _statusCode = statusCode;
+        };
+
+        auto contentRange = [&](std::string& out, const range::Span& span)
+        {
+            out += "Content-Range: bytes ";
+            out += std::to_string(span._first);
+            out += "-";
+            out += std::to_string(span._last);
+            out += "/";
+            out += std::to_string(size);
+            out += "\r\n";
+        };
+
+        // nothing of the body goes out
+        if(_spans.empty())
+        {
+            statusLine(416);
+            _head += "Content-Range: bytes */";
+            _head += std::to_string(size);
+            _head += "\r\nContent-Length: 0\r\n";
+            return;
+        }
+
+        statusLine(206);
+
+        if(1 == _spans.size())
+        {
+            if(_contentType)
+            {
+                _head += "Content-Type: ";
+                _head += *_contentType;
+                _head += "\r\n";
+            }
+
+            contentRange(_head, _spans.front());
+            _head += "Content-Length: ";
+            _head += std::to_string(_spans.front()._last - _spans.front()._first + 1);
+            _head += "\r\n";
+            return;
+        }
+
+        // each part is preceded by its own head, they are made once here and counted into the length
+        std::string boundary = range::boundary();
+        uint64 length{};
+        for(const range::Span& span : _spans)
+        {
+            std::string& partHead = _partHeads.emplace_back();
+            partHead += "\r\n--";
+            partHead += boundary;
+            partHead += "\r\n";
+            if(_contentType)
+            {
+                partHead += "Content-Type: ";
+                partHead += *_contentType;
+                partHead += "\r\n";
+            }
+            contentRange(partHead, span);
+            partHead += "\r\n";
+
+            length += partHead.size() + span._last - span._first + 1;
+        }
+
+        _partsTrailer = "\r\n--" + boundary + "--\r\n";
+        length += _partsTrailer.size();
+
+        _head += "Content-Type: multipart/byteranges; boundary=";
+        _head += boundary;
+        _head += "\r\nContent-Length: ";
+        _head += std::to_string(length);
+        _head += "\r\n";
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::pendFraming(std::string_view framing)
+    {
+        Bytes bytes;
+        bytes.end().write(framing.data(), framing.size());
+        _pending.push_back(Pending{-1, 0, 0, std::move(bytes), false});
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::selectRanges(uint64 size, auto&& framing, auto&& source)
+    {
+        // the piece covers [begin, end) of the representation, only what falls into the spans passes
+        uint64 begin = _bodyOffset;
+        uint64 end = begin + size;
+        _bodyOffset = end;
+
+        for(; _span < _spans.size(); ++_span)
+        {
+            const range::Span& span = _spans[_span];
+            if(span._first >= end)
+                return;
+
+            uint64 from = std::max(begin, span._first);
+            uint64 to = std::min(end, span._last + 1);
+
+            if(from == span._first && !_partHeads.empty())
+                framing(std::exchange(_partHeads[_span], {}));
+
+            if(from < to)
+                source(from - begin, to - from);
+
+            if(to <= span._last)
+                return;
+        }
+
+        if(!_partsTrailer.empty())
+            framing(std::exchange(_partsTrailer, {}));
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::notModified(std::string_view etag, uint64 lastModified)
+    {
+        if(!_safeRequest)
+            return false;
+
+        // If-Modified-Since is not looked at when If-None-Match is present
+        bool match = _ifNoneMatch ?
+                         conditional::noneMatch(*_ifNoneMatch, etag) :
+                         _ifModifiedSince && lastModified && conditional::notModifiedSince(*_ifModifiedSince, lastModified);
+
+        if(!match)
+            return false;
+
+        if(_deferContinue)
+            decideBody(BodyDecision::close);
+
+        // no body, so nothing is produced or compressed for it
+        _statusCode = 304;
+        _head.reserve(_headReserve);
+        if(!serialized(serializer::responseFirstLine(_head, api::http::firstLine::Version::HTTP_1_1, _statusCode, {})))
+            return false;
+
+        if(_addDate)
+            DateCache::instance().write(_head);
+
+        connectionHead(true, false);
+
+        if(!etag.empty())
+        {
+            _head += "ETag: ";
+            _head += etag;
+            _head += "\r\n";
+        }
+
+        _head += "\r\n";
+        flushHead();
         flushBuffer();
+        return true;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::writeBody(Bytes&& data, bool done)
+    {
+        if(_chunked)
+            return writeChunked(std::move(data), done);
+
+        _buffer.end().write(std::move(data));
+        return true;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::pump()
+    {
+        if(_pumping)
+            return;
+
+        _pumping = true;
+
+        // read ahead no further than the output watermarks allow, resumed by pressure(false)
+        while(!_pending.empty() && !_support->outputPaused())
+        {
+            Pending& pending = _pending.front();
+
+            Bytes portion;
+            if(0 > pending._fd)
+                portion = std::move(pending._bytes);
+            else if(!readFile(pending, portion))
+            {
+                _support->close(exception::buildInstance<api::http::error::response::BadResponse>());
+                return;
+            }
+
+            bool last = 0 > pending._fd || !pending._size;
+            bool done = last && pending._done;
+            if(last)
+            {
+                if(0 <= pending._fd)
+                    ::close(pending._fd);
+                _pending.pop_front();
+            }
+
+            if(!writeBody(std::move(portion), done))
+                return;
+
+            flushBuffer();
+        }
+
+        _pumping = false;
+
+        if(_pending.empty() && _doneAfterPending)
+        {
+            _doneAfterPending = false;
+
+            if(_chunked && !writeChunked(Bytes{}, true))
+                return;
+
+            // may be the last touch before the response is released
+            flushBuffer();
+            finish();
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::readFile(Pending& pending, Bytes& portion)
+    {
+        // straight into the output segments, no intermediate buffer
+        bytes::Alter out{portion.end()};
+
+        uint64 want = std::min<uint64>(pending._size, _filePortion);
+        while(want)
+        {
+            uint32 bufSize{};
+            void* buf = out.prepareWriteBuffer(bufSize);
+            bufSize = static_cast<uint32>(std::min<uint64>(bufSize, want));
+
+            ssize_t got = ::pread(pending._fd, buf, bufSize, static_cast<off_t>(pending._offset));
+            if(0 > got && EINTR == errno)
+                continue;
+
+            if(0 >= got)
+            {
+                if(got)
+                    LOGD("file body: " << std::strerror(errno));
+                else
+                    LOGD("file body: shorter than declared");
+                return false;
+            }
+
+            out.commitWriteBuffer(static_cast<uint32>(got));
+            pending._offset += static_cast<uint64>(got);
+            pending._size -= static_cast<uint64>(got);
+            want -= static_cast<uint64>(got);
+        }
+
+        return true;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::hasBody() const
+    {
+        return _statusCode >= 200 && 204 != _statusCode && 304 != _statusCode && !_headRequest;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    bool Response::writeChunked(Bytes&& data, bool finish)
+    {
+        // nothing may follow the last chunk
+        if(_bodyFinished && !data.empty())
+        {
+            _support->close(exception::buildInstance<api::http::error::response::BadResponse>());
+            return false;
+        }
+
+        if(_bodyFinished)
+            return true;
+
+        // cacheable body is taken whole, unless it is too big for the cache
+        if(_collecting)
+        {
+            _collected.end().write(std::move(data));
+            if(!finish && _collected.size() <= CompressedCache::_maxSourceSize)
+                return true;
+
+            _collecting = false;
+
+            if(finish)
+            {
+                std::optional<Bytes> compressed = CompressedCache::instance().get(std::move(_collected), _coding);
+                if(!compressed)
+                {
+                    _support->close(exception::buildInstance<api::http::error::response::BadResponse>());
+                    return false;
+                }
+
+                writeChunk(std::move(*compressed));
+                _buffer.end().write("0\r\n\r\n");
+                _bodyFinished = true;
+                return true;
+            }
+
+            data = std::move(_collected);
+        }
+
+        // compress::None passes the data through as is
+        std::optional<Bytes> coded = _compressor.visit([&](auto& concrete)
+        {
+            return concrete.exec(std::move(data), finish);
+        });
+
+        if(!coded)
+        {
+            _support->close(exception::buildInstance<api::http::error::response::BadResponse>());
+            return false;
+        }
+
+        writeChunk(std::move(*coded));
+
+        if(finish)
+        {
+            _buffer.end().write("0\r\n\r\n");
+            _bodyFinished = true;
+        }
+
+        return true;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::writeChunk(Bytes&& chunk)
+    {
+        // an empty chunk would end the body
+        if(chunk.empty())
+            return;
+
+        char size[sizeof(std::size_t) * 2 + 2];
+        std::to_chars_result res = std::to_chars(size, size + sizeof(size) - 2, chunk.size(), 16);
+        *res.ptr++ = '\r';
+        *res.ptr++ = '\n';
+
+        bytes::Alter out{_buffer.end()};
+        out.write(size, static_cast<std::size_t>(res.ptr - size));
+        out.write(std::move(chunk));
+        out.write("\r\n");
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::flushHead()
+    {
+        if(_head.empty())
+            return;
+
+        _buffer.end().write(_head.data(), _head.size());
+        _head.clear();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    void Response::pressure(bool paused)
+    {
+        // not from inside the pressure notification, outputs are being iterated there
+        if(!paused && !_pending.empty())
+            _pumpTimer.start();
+
+        _pressureTimer.start();
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -11,12 +11,23 @@
 #include "io/plexus.hpp"
 #include "io/outputBase.hpp"
 #include "../inputSlicer/result.hpp"
+#include "../serializer.hpp"
+#include "compression.hpp"
+#include "range.hpp"
 
 namespace dci::module::www::http::server
 {
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     class Request;
 
+    // what becomes of a body the client holds until 100 Continue
+    enum class BodyDecision
+    {
+        accept,
+        skip,
+        close,
+    };
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     class Response
         : public io::OutputBase<io::Plexus<Request, Response, true>, Response, api::http::server::Response<>::Opposite>
@@ -25,15 +36,133 @@ namespace dci::module::www::http::server
         using Base = io::OutputBase<io::Plexus<Request, Response, true>, Response, api::http::server::Response<>::Opposite>;
 
     public:
-        Response(Support* support, api::http::server::Response<>::Opposite&& api);
+        Response(Support* support, api::http::server::Response<>::Opposite&& api, const api::http::server::Settings& settings);
         ~Response();
 
         void requestFailed(inputSlicer::Result inputSlicerResult);
 
+        // what of the request affects the response
+        void request(api::http::firstLine::Method method, api::http::firstLine::Version version);
+        void requestHeader(api::http::header::KeyRecognized key, std::string_view value);
+        void expectContinue();
+        void lastRequest();
+        bool persistent() const;
+
     public:
         void someWrote();
+        void pressure(bool paused);
+
+    private:
+        void decideBody(BodyDecision decision);
+        void applyBodyDecision();
+        void finish();
+
+    private:
+        bool serialized(serializer::Result result);
+        void inspect(api::http::header::KeyRecognized key, std::string_view value);
+        bool finishHead();
+        void connectionHead(bool delimited, bool http10);
+        bool notModified(std::string_view etag, uint64 lastModified);
+        bool rangeCandidate() const;
+        void rangedHead(range::Spans&& spans, uint64 size);
+        void selectRanges(uint64 size, auto&& framing, auto&& source);
+        void pendFraming(std::string_view framing);
+        bool writeBody(Bytes&& data, bool done);
+        bool hasBody() const;
+        bool writeChunked(Bytes&& data, bool finish);
+        void writeChunk(Bytes&& chunk);
+        void flushHead();
+
+    private:
+        struct Pending
+        {
+            int     _fd;        // -1 for bytes
+            uint64  _offset;
+            uint64  _size;
+            Bytes   _bytes;
+            bool    _done;
+        };
+
+        void pump();
+        bool readFile(Pending& pending, Bytes& portion);
 
     private:
         bool _someWote{};
+        bool _addDate{};
+
+        // Expect: 100-continue, the request body waits for the producer unless it is not asked
+        bool                        _deferContinue{};
+        bool                        _expectContinue{};
+        std::optional<BodyDecision> _bodyDecision;
+        bool                        _closeAfter{};
+        bool                        _hasConnection{};
+
+        // keep-alive, HTTP/1.0 asks for it explicitly and HTTP/1.1 opts out
+        bool                        _requestHttp10{};
+        bool                        _requestClose{};
+        bool                        _requestKeepAlive{};
+        bool                        _lastRequest{};
+
+        // body parts waiting for the output to drain, in order
+        static constexpr uint64 _filePortion = 64 * 1024;
+        std::deque<Pending> _pending;
+        bool                _pumping{};
+        bool                _doneAfterPending{};
+        poll::Timer         _pumpTimer{std::chrono::milliseconds{0}};
+
+        // producer hears of pressure changes from its own turn, it may answer with data or done right away
+        bool                _apiPaused{};
+        poll::Timer         _pressureTimer{std::chrono::milliseconds{0}};
+
+        api::http::firstLine::Version       _version{};
+        bool                                _http11{};
+        std::size_t                         _firstLineSize{};
+        api::http::firstLine::StatusCode    _statusCode{};
+        bool                                _headRequest{};
+
+        // conditional request, validators from the application are checked against these
+        bool                                _safeRequest{};
+        std::optional<String>               _ifNoneMatch;
+        std::optional<String>               _ifModifiedSince;
+        bool                                _notModified{};
+        String                              _etag;
+        uint64                              _lastModified{};
+        bool                                _hasEtag{};
+        bool                                _hasLastModified{};
+
+        // byte ranges, the whole representation comes from the application and only the selected parts go out
+        bool                                _acceptRanges{};
+        std::optional<String>               _range;
+        std::optional<String>               _ifRange;
+        std::optional<String>               _contentType;
+        bool                                _ranged{};
+        range::Spans                        _spans;
+        std::size_t                         _span{};
+        uint64                              _bodyOffset{};
+        std::vector<std::string>            _partHeads;
+        std::string                         _partsTrailer;
+
+        // body compression, negotiated when the head is done
+        bool                                _compress{};
+        uint32                              _compressMinSize{};
+        compression::Codings                _acceptedCodings{};
+        std::optional<String>               _contentLength;
+        bool                                _compressibleType{};
+        bool                                _hasContentEncoding{};
+        bool                                _hasVary{};
+        compression::Compressor             _compressor;
+        compression::Coding                 _coding{};
+        bool                                _cacheable{};
+        bool                                _collecting{};
+        Bytes                               _collected;
+
+        // body framing, chunked when its length is not known ahead
+        bool                                _hasTransferEncoding{};
+        bool                                _chunked{};
+        bool                                _bodyFinished{};
+
+        // status line and headers are gathered here and go to the output by one write
+        static constexpr std::size_t _headReserve = 512;
+        std::string _head;
     };
 }
@@ -0,0 +1,52 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#include "pch.hpp"
+#include "settings.hpp"
+
+namespace dci::module::www::http::server::settings
+{
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    api::http::server::Settings applyDefaults(api::http::server::Settings&& settings)
+    {
+        auto apply = [](auto& field, auto dflt)
+        {
+            if(!field)
+                field = static_cast<std::remove_reference_t<decltype(field)>>(dflt);
+        };
+
+        apply(settings.maxInFlight, _defaultMaxInFlight);
+        apply(settings.outputHighWatermark, _defaultOutputHighWatermark);
+        apply(settings.outputLowWatermark, std::min(_defaultOutputLowWatermark, settings.outputHighWatermark / 2));
+
+        if(settings.outputLowWatermark >= settings.outputHighWatermark)
+            settings.outputLowWatermark = settings.outputHighWatermark / 2;
+
+        apply(settings.compressMinSize, _defaultCompressMinSize);
+
+        const inputSlicer::Limits limits;
+        apply(settings.maxUriSize, limits._uriSize);
+        apply(settings.maxHeaderKeySize, limits._headerKeySize);
+        apply(settings.maxHeaderValueSize, limits._headerValueSize);
+        apply(settings.maxHeadersCount, limits._headersCount);
+        apply(settings.maxHeadersSize, limits._headersSize);
+
+        return std::move(settings);
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    inputSlicer::Limits inputLimits(const api::http::server::Settings& settings)
+    {
+        inputSlicer::Limits limits;
+        limits._uriSize = settings.maxUriSize;
+        limits._headerKeySize = settings.maxHeaderKeySize;
+        limits._headerValueSize = settings.maxHeaderValueSize;
+        limits._headersCount = settings.maxHeadersCount;
+        limits._headersSize = settings.maxHeadersSize;
+        return limits;
+    }
+}
@@ -0,0 +1,26 @@
+/* This file is part of the the dci project. Copyright (C) 2013-2023 vopl, shtoba.
+   This program is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public
+   License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+   of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+   You should have received a copy of the GNU Affero General Public License along with this program. If not, see <https://www.gnu.org/licenses/>. */
+
+#pragma once
+
+#include "pch.hpp"
+#include "../inputSlicer/limits.hpp"
+
+namespace dci::module::www::http::server::settings
+{
+    constexpr uint32 _defaultMaxInFlight = 32;
+    constexpr uint32 _defaultOutputHighWatermark = 256 * 1024;
+    constexpr uint32 _defaultOutputLowWatermark = 64 * 1024;
+    constexpr uint32 _defaultCompressMinSize = 1024;
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    // zero fields are replaced with defaults, except for the keep-alive and body rate limits where zero disables them
+    api::http::server::Settings applyDefaults(api::http::server::Settings&& settings);
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    inputSlicer::Limits inputLimits(const api::http::server::Settings& settings);
+}
@@ -14,6 +14,7 @@ namespace dci::module::www::io
     enum class InputProcessResult
     {
         needMore,
+        wait,   // input holds the rest of the data until resumeInput()
         done,
         bad,
     };
@@ -24,6 +24,7 @@ namespace dci::module::www::io
         bool isFail();
         bool isDone();
         void allowWrite();
+        std::size_t bufferedSize() const;
 
     protected:
         void flushBuffer();
@@ -47,11 +47,26 @@ namespace dci::module::www::io
         flushBuffer();
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class Support, class Impl, class Api>
+    std::size_t OutputBase<Support, Impl, Api>::bufferedSize() const
+    {
+        return _buffer.size();
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <class Support, class Impl, class Api>
     void OutputBase<Support, Impl, Api>::flushBuffer()
     {
-        if(_writeAllowed && !_buffer.empty())
+        if(!_writeAllowed)
+        {
+            // waits behind preceding outputs, still counts against the output watermarks
+            if(!_buffer.empty())
+                this->_support->buffered(static_cast<Impl*>(this));
+            return;
+        }
+
+        if(!_buffer.empty())
         {
             this->_support->write(std::move(_buffer));
             if constexpr (requires {{static_cast<Impl*>(this)->someWrote()};})
@@ -29,9 +29,20 @@ namespace dci::module::www::io
         template <class... OutputArgs>
         void emplace(OutputArgs&&... outputArgs) requires (serverMode);
 
+        InputImpl& input() requires (serverMode);
+        void resumeInput() requires (serverMode);
+
+    public:
+        void limitInFlight(std::size_t maxInFlight) requires (serverMode);
+        void limitOutput(std::size_t highWatermark, std::size_t lowWatermark);
+        void limitIdle(std::chrono::milliseconds timeout) requires (serverMode);
+
     public:
         void done(OutputImpl* output);
         void write(Bytes data);
+        void buffered(OutputImpl* output);
+        bool outputPaused() const;
+        std::size_t outputQueued() const;
 
         void apiWantClose(OutputImpl* output);
         void apiWantClose(InputImpl* input);
@@ -43,6 +54,14 @@ namespace dci::module::www::io
 
         sbs::Owner _sol;
 
+    private:
+        void startReceive();
+        void stopReceive();
+        void processReceived();
+        void updateOutputPressure();
+        void updateIdle();
+        void flushSend();
+
     private:
         idl::net::stream::Channel<> _netStreamChannel;
         idl::www::Unreliable<>::Opposite _unreliableOpposite;
@@ -56,6 +75,26 @@ namespace dci::module::www::io
         bool _receiveStarted{};
         Bytes _receivedData;
         InputProcessResult _inputProcessResult{};
+
+        std::size_t _maxInFlight{~std::size_t{}};
+        bool _inputAtBoundary{true};
+        bool _inputWaits{};
+        bool _inputResumed{};
+        bool _processing{};
+
+        std::size_t _outputHighWatermark{~std::size_t{}};
+        std::size_t _outputLowWatermark{~std::size_t{}};
+        std::size_t _outputQueued{};
+        bool _outputPaused{};
+
+        // nothing in flight and nothing received, the connection is closed if it stays so
+        std::optional<poll::Timer> _idleTimer;
+
+        // writes made within one event loop turn go to the stream as a single send
+        static constexpr std::size_t _sendThreshold = 64 * 1024;
+        Bytes _sendBuffer;
+        poll::Timer _sendTimer{std::chrono::milliseconds{0}};
+        bool _sendScheduled{};
     };
 }
 
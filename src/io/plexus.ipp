@@ -29,12 +29,18 @@ namespace dci::module::www::io
         if constexpr(serverMode)
             _inputHolder.setSupport(this);
 
+        _sendTimer.tick() += _sol * [this]()
+        {
+            flushSend();
+        };
+
         // in  send            (bytes);
         // out sended          (uint64 now, uint64 wait);
-        // _netStreamChannel->sended() += _sol * [](uint64 now, uint64 wait)
-        // {
-        //     dbgFatal("not impl");
-        // };
+        _netStreamChannel->sended() += _sol * [this](uint64 /*now*/, uint64 wait)
+        {
+            _outputQueued = wait + _sendBuffer.size();
+            updateOutputPressure();
+        };
 
         // in  startReceive    ();
 
@@ -42,63 +48,10 @@ namespace dci::module::www::io
         _netStreamChannel->received() += _sol * [this](Bytes data)
         {
             _receivedData.end().write(std::move(data));
+            processReceived();
 
-            auto stopReceive = [&]
-            {
-                if(_receiveStarted && _netStreamChannel)
-                {
-                    _receiveStarted = false;
-                    _netStreamChannel->stopReceive();
-                }
-            };
-
-            if(InputProcessResult::bad == _inputProcessResult)
-            {
-                stopReceive();
-                return;
-            }
-
-            if constexpr(serverMode)
-            {
-                while(!_receivedData.empty())
-                {
-                    {
-                        bytes::Alter receivedDataAlter = _receivedData.begin();
-                        _inputProcessResult = _inputHolder.process(receivedDataAlter);
-                    }
-
-                    switch(_inputProcessResult)
-                    {
-                    case InputProcessResult::needMore:
-                    case InputProcessResult::done:
-                        break;
-
-                    case InputProcessResult::bad:
-                        stopReceive();
-                        return;
-                    }
-                }
-            }
-            else
-            {
-                dbgFatal("not impl");
-                // while(!_receivedData.empty() && !_inputHolder.empty())
-                // {
-                //     if(_inputHolder.front().process(_receivedData.begin()))
-                //         _inputHolder.pop_front();
-                //     else if(!_receivedData.empty())
-                //     {
-                //         close(exception::buildInstance<api::http::error::response::BadResponse>());
-                //         return;
-                //     }
-                // }
-
-                // if(!_receivedData.empty())
-                // {
-                //     _receiveStarted = false;
-                //     _netStreamChannel->stopReceive();
-                // }
-            }
+            // responses made right from io() leave with this turn
+            flushSend();
         };
 
         // in  stopReceive     ();
@@ -115,8 +68,8 @@ namespace dci::module::www::io
             close();
         };
 
-        if(serverMode || _receiveStarted)
-            _netStreamChannel->startReceive();
+        if constexpr(serverMode)
+            startReceive();
 
         // in close();
         _unreliableOpposite->close() += _sol * [&]()
@@ -145,11 +98,7 @@ namespace dci::module::www::io
                 },
                 std::move(inputArgs));
 
-            if(!_receiveStarted)
-            {
-                _receiveStarted = true;
-                _netStreamChannel->startReceive();
-            }
+            startReceive();
         }
 
         {
@@ -159,8 +108,14 @@ namespace dci::module::www::io
                 },
                 std::move(outputArgs));
 
+            // the response is parsed knowing the request method
+            _outputHolder.back().setResponse(&_inputHolder.back());
             _outputHolder.front().allowWrite();
         }
+
+        // data left unclaimed by previous responses
+        if(!_receivedData.empty())
+            processReceived();
     }
 
     template <class InputImpl, class OutputImpl, bool serverMode>
@@ -169,7 +124,63 @@ namespace dci::module::www::io
     {
         _outputHolder.emplace_back(this, std::forward<OutputArgs>(outputArgs)...);
         _outputHolder.front().allowWrite();
-        _inputHolder.setResponse(&_outputHolder.front());
+        _inputHolder.setResponse(&_outputHolder.back());
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::limitInFlight(std::size_t maxInFlight) requires (serverMode)
+    {
+        dbgAssert(maxInFlight);
+        _maxInFlight = maxInFlight;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::limitIdle(std::chrono::milliseconds timeout) requires (serverMode)
+    {
+        dbgAssert(timeout.count());
+        _idleTimer.emplace(timeout);
+        _idleTimer->tick() += _sol * [this]()
+        {
+            close();
+        };
+
+        updateIdle();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    InputImpl& Plexus<InputImpl, OutputImpl, serverMode>::input() requires (serverMode)
+    {
+        return _inputHolder;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::resumeInput() requires (serverMode)
+    {
+        if(!_inputWaits)
+            return;
+
+        // the input may have something to finish even with no more data
+        _inputWaits = false;
+        _inputResumed = true;
+        if(_netStreamChannel)
+        {
+            processReceived();
+            flushSend();
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::limitOutput(std::size_t highWatermark, std::size_t lowWatermark)
+    {
+        dbgAssert(lowWatermark < highWatermark);
+        _outputHighWatermark = highWatermark;
+        _outputLowWatermark = lowWatermark;
+        updateOutputPressure();
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -178,20 +189,25 @@ namespace dci::module::www::io
     {
         dbgAssert(!_outputHolder.empty());
 
-        while(!_outputHolder.empty())
+        while(!_outputHolder.empty() && _outputHolder.front().isDone())
         {
-            _outputHolder.front().allowWrite();
-            if(_outputHolder.front().isDone())
+            if(_outputHolder.front().isFail())
             {
-                if(_outputHolder.front().isFail())
-                {
-                    close();
-                    break;
-                }
-                _outputHolder.pop_front();
+                close();
+                return;
             }
-            else
-                break;
+            _outputHolder.pop_front();
+        }
+
+        // next one flushes what it buffered while waiting, and may come back here being done
+        if(!_outputHolder.empty())
+            _outputHolder.front().allowWrite();
+
+        // some room for pipelined requests may appear
+        if constexpr(serverMode)
+        {
+            if(_netStreamChannel)
+                processReceived();
         }
     }
 
@@ -199,7 +215,44 @@ namespace dci::module::www::io
     template <class InputImpl, class OutputImpl, bool serverMode>
     void Plexus<InputImpl, OutputImpl, serverMode>::write(Bytes data)
     {
-        _netStreamChannel->send(std::move(data));
+        _outputQueued += data.size();
+        _sendBuffer.end().write(std::move(data));
+
+        if(_sendBuffer.size() >= _sendThreshold)
+            flushSend();
+        else if(!_sendScheduled)
+        {
+            _sendScheduled = true;
+            _sendTimer.start();
+        }
+
+        updateOutputPressure();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::buffered(OutputImpl* /*output*/)
+    {
+        updateOutputPressure();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    bool Plexus<InputImpl, OutputImpl, serverMode>::outputPaused() const
+    {
+        return _outputPaused;
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    std::size_t Plexus<InputImpl, OutputImpl, serverMode>::outputQueued() const
+    {
+        // sent but not yet taken by the peer, plus still buffered in outputs
+        std::size_t total = _outputQueued;
+        for(const OutputImpl& output : _outputHolder)
+            total += output.bufferedSize();
+
+        return total;
     }
 
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -228,6 +281,137 @@ namespace dci::module::www::io
         close(exception::buildInstance<api::http::error::BadInput>());
     }
 
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::startReceive()
+    {
+        if(!_receiveStarted && _netStreamChannel)
+        {
+            _receiveStarted = true;
+            _netStreamChannel->startReceive();
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::stopReceive()
+    {
+        if(_receiveStarted && _netStreamChannel)
+        {
+            _receiveStarted = false;
+            _netStreamChannel->stopReceive();
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::processReceived()
+    {
+        if(InputProcessResult::bad == _inputProcessResult)
+        {
+            stopReceive();
+            return;
+        }
+
+        if constexpr(serverMode)
+        {
+            // responses emitted synchronously from io() call done() from within the loop below
+            if(_processing)
+                return;
+
+            _processing = true;
+
+            for(;;)
+            {
+                // each dispatched request holds a response in _outputHolder until it is done;
+                // a waiting input leaves the rest of the data unread, in the socket too
+                if(_inputWaits || _outputPaused || (_inputAtBoundary && _outputHolder.size() >= _maxInFlight))
+                {
+                    _processing = false;
+                    stopReceive();
+                    return;
+                }
+
+                bool resumed = std::exchange(_inputResumed, false);
+                if(_receivedData.empty() && !resumed)
+                    break;
+
+                {
+                    bytes::Alter receivedDataAlter = _receivedData.begin();
+                    _inputProcessResult = _inputHolder.process(receivedDataAlter);
+                }
+
+                switch(_inputProcessResult)
+                {
+                case InputProcessResult::needMore:
+                    _inputAtBoundary = false;
+                    break;
+
+                case InputProcessResult::wait:
+                    _inputAtBoundary = false;
+                    _inputWaits = true;
+                    break;
+
+                case InputProcessResult::done:
+                    _inputAtBoundary = true;
+                    break;
+
+                case InputProcessResult::bad:
+                    _processing = false;
+                    stopReceive();
+                    return;
+                }
+            }
+
+            _processing = false;
+            startReceive();
+            updateIdle();
+        }
+        else
+        {
+            // a consumer may issue the next request right from a response callback
+            if(_processing)
+                return;
+
+            _processing = true;
+
+            // responses go in the order of requests, each one takes its part of the data
+            while(!_receivedData.empty() && !_inputHolder.empty())
+            {
+                {
+                    bytes::Alter receivedDataAlter = _receivedData.begin();
+                    _inputProcessResult = _inputHolder.front().process(receivedDataAlter);
+                }
+
+                switch(_inputProcessResult)
+                {
+                case InputProcessResult::needMore:
+                    break;
+
+                case InputProcessResult::wait:
+                    // responses are never held, nothing would resume them
+                    unreacheable();
+                    break;
+
+                case InputProcessResult::done:
+                    _inputHolder.pop_front();
+                    break;
+
+                case InputProcessResult::bad:
+                    _processing = false;
+                    stopReceive();
+                    return;
+                }
+            }
+
+            _processing = false;
+
+            // nobody waits for the rest, it stays until the next request
+            if(!_receivedData.empty())
+                stopReceive();
+        }
+    }
+
     /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
     template <class InputImpl, class OutputImpl, bool serverMode>
     void Plexus<InputImpl, OutputImpl, serverMode>::close(ExceptionPtr e)
@@ -235,7 +419,10 @@ namespace dci::module::www::io
         _sol.flush();
 
         if(_netStreamChannel)
+        {
+            flushSend();
             ChannelSoftClosing::instance().push(std::exchange(_netStreamChannel, {}));
+        }
 
         _receiveStarted = false;
         _receivedData.clear();
@@ -273,4 +460,58 @@ namespace dci::module::www::io
             std::exchange(_unreliableOpposite, {})->closed();
         }
     }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::updateOutputPressure()
+    {
+        std::size_t total = outputQueued();
+
+        if(!_outputPaused && total >= _outputHighWatermark)
+        {
+            _outputPaused = true;
+            stopReceive();
+
+            if constexpr(requires(OutputImpl& output) {output.pressure(true);})
+                for(OutputImpl& output : _outputHolder)
+                    output.pressure(true);
+        }
+        else if(_outputPaused && total <= _outputLowWatermark)
+        {
+            _outputPaused = false;
+
+            if constexpr(requires(OutputImpl& output) {output.pressure(false);})
+                for(OutputImpl& output : _outputHolder)
+                    output.pressure(false);
+
+            if constexpr(serverMode)
+            {
+                if(_netStreamChannel)
+                    processReceived();
+            }
+        }
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::updateIdle()
+    {
+        if(!_idleTimer)
+            return;
+
+        // called on each activity, so the countdown restarts from the last one
+        _idleTimer->stop();
+        if(_netStreamChannel && _inputAtBoundary && _outputHolder.empty() && _receivedData.empty())
+            _idleTimer->start();
+    }
+
+    /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+    template <class InputImpl, class OutputImpl, bool serverMode>
+    void Plexus<InputImpl, OutputImpl, serverMode>::flushSend()
+    {
+        _sendScheduled = false;
+
+        if(!_sendBuffer.empty() && _netStreamChannel)
+            _netStreamChannel->send(std::move(_sendBuffer));
+    }
 }
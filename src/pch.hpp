@@ -18,7 +18,12 @@
 
 #include <bit>
 #include <deque>
+#include <list>
+#include <memory_resource>
+#include <set>
+#include <span>
 #include <string_view>
+#include <unordered_map>
 #include "www.hpp"
 
 namespace dci::module::www
@@ -7,6 +7,9 @@
 
 #include <dci/test.hpp>
 #include <dci/host.hpp>
+#include <dci/poll.hpp>
+#include <dci/cmt.hpp>
+#include <dci/utils/s2f.hpp>
 #include "www.hpp"
 
 using namespace dci;
@@ -18,3 +21,122 @@ using namespace dci::idl;
 TEST(module_www, client)
 {
 }
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, client_responses)
+{
+    Manager* manager = testManager();
+    net::Host<> netHost = *manager->createService<net::Host<>>();
+    www::Factory<> wwwFactory = *manager->createService<www::Factory<>>();
+
+    net::stream::Server<> netServer = *netHost->streamServer();
+    *netServer->listen(net::Ip4Endpoint{{127,0,0,19}, 0});
+    utils::S2f accepted = netServer->accepted();
+
+    auto connected = netHost->streamClient()->connect(*netServer->localEndpoint());
+    www::http::client::Channel<> cln = *wwwFactory->httpClientChannel(*connected);
+    net::stream::Channel<> peer = *accepted;
+
+    sbs::Owner sol;
+
+    std::string peerData;
+    peer->received() += sol * [&](Bytes&& data)
+    {
+        peerData += data.toString();
+    };
+    peer->startReceive();
+
+    struct Got
+    {
+        std::string _status;
+        std::size_t _headers{};
+        std::string _body;
+        bool        _dataDone{};
+        bool        _done{};
+    };
+    std::deque<Got> gots;
+
+    std::deque<std::tuple<www::http::client::Request<>, www::http::client::Response<>>> ios;
+    auto issue = [&](www::http::firstLine::Method method, const char* uri)
+    {
+        auto& [request, response] = ios.emplace_back();
+        cln->io(request.init2(), response.init2());
+
+        Got* got = &gots.emplace_back();
+
+        response->firstLine() += sol * [got](www::http::firstLine::Version version, www::http::firstLine::StatusCode statusCode, primitives::String&& statusText)
+        {
+            EXPECT_EQ(version, www::http::firstLine::Version::HTTP_1_1);
+            got->_status = std::to_string(statusCode) + " " + statusText;
+        };
+
+        response->headers() += sol * [got](primitives::List<www::http::Header>&& headers, bool /*done*/)
+        {
+            got->_headers += headers.size();
+        };
+
+        response->data() += sol * [got](Bytes&& data, bool done)
+        {
+            got->_body += data.toString();
+            got->_dataDone |= done;
+        };
+
+        response->done() += sol * [got]()
+        {
+            got->_done = true;
+        };
+
+        request->firstLine(method, uri, www::http::firstLine::Version::HTTP_1_1);
+        request->headers(primitives::List<www::http::Header>{{www::http::header::KeyRecognized::Host, "localhost"}}, true);
+        request->done();
+    };
+
+    auto play = [&]
+    {
+        for(int i{}; i<20; ++i)
+            poll::timeout(std::chrono::milliseconds{1}).wait();
+    };
+
+    issue(www::http::firstLine::Method::GET, "/a");
+    issue(www::http::firstLine::Method::HEAD, "/b");
+    issue(www::http::firstLine::Method::GET, "/c");
+    issue(www::http::firstLine::Method::GET, "/d");
+    play();
+
+    EXPECT_EQ(peerData,
+              "GET /a HTTP/1.1\r\nHost: localhost\r\n\r\n"
+              "HEAD /b HTTP/1.1\r\nHost: localhost\r\n\r\n"
+              "GET /c HTTP/1.1\r\nHost: localhost\r\n\r\n"
+              "GET /d HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+    // interim response is consumed, the head answer carries no body, the last one runs until close
+    peer->send("HTTP/1.1 100 Continue\r\n\r\n"
+               "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\nabc"
+               "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\n"
+               "HTTP/1.1 201 Created\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nxyz\r\n0\r\n\r\n"
+               "HTTP/1.1 200\r\nConnection: close\r\n\r\n");
+    peer->send("12");
+    peer->send("345");
+    play();
+
+    ASSERT_EQ(gots.size(), 4);
+    EXPECT_FALSE(gots[3]._done);
+    peer->close();
+    play();
+
+    auto check = [&](const Got& got, const char* status, std::size_t headers, const char* body)
+    {
+        EXPECT_EQ(got._status, status);
+        EXPECT_EQ(got._headers, headers);
+        EXPECT_EQ(got._body, body);
+        EXPECT_TRUE(got._dataDone);
+        EXPECT_TRUE(got._done);
+    };
+
+    check(gots[0], "200 OK", 1, "abc");
+    check(gots[1], "200 OK", 1, "");
+    check(gots[2], "201 Created", 1, "xyz");
+    check(gots[3], "200 ", 1, "12345");
+
+    sol.flush();
+}
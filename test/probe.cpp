@@ -38,7 +38,7 @@ namespace
         return
         {
             *wwwFactory->httpClientChannel(*connected),
-            *wwwFactory->httpServerChannel(*accepted)
+            *wwwFactory->httpServerChannel(*accepted, www::http::server::Settings{})
         };
     }
 }
@@ -71,7 +71,7 @@ TEST(module_www, probe)
             if(!done)
                 return;
 
-            ASSERT_EQ(2, srvHeaders.size());
+            ASSERT_EQ(3, srvHeaders.size());
 
             EXPECT_EQ(srvHeaders[0].key, www::http::header::KeyRecognized::Host);
             EXPECT_EQ(srvHeaders[0].value, "localhost");
@@ -79,6 +79,9 @@ TEST(module_www, probe)
             EXPECT_EQ(srvHeaders[1].key, "x-my-header");
             EXPECT_EQ(srvHeaders[1].value, "x-my-value");
 
+            EXPECT_EQ(srvHeaders[2].key, www::http::header::KeyRecognized::Content_Length);
+            EXPECT_EQ(srvHeaders[2].value, "3");
+
             srvHeadersDone.raise();
         };
 
@@ -105,6 +108,7 @@ TEST(module_www, probe)
                     primitives::List<www::http::Header> {
                         {www::http::header::KeyRecognized::Host, "localhost"},
                         {"x-my-header", "x-my-value"},
+                        {www::http::header::KeyRecognized::Content_Length, "3"},
                     }, true);
         clnReq->data("xyz", true);
         clnReq->done();
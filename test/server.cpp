@@ -12,6 +12,7 @@
 #include <dci/exception.hpp>
 #include <dci/utils/s2f.hpp>
 #include "www.hpp"
+#include <unistd.h>
 
 using namespace dci;
 using namespace dci::host;
@@ -45,6 +46,7 @@ struct Spectacle
 
     struct OutputFailed     : Tuple<std::string>                               { using Tuple::Tuple; };
     struct OutputClosed     : Tuple<>                                          { using Tuple::Tuple; };
+    struct OutputExpectContinue : Tuple<>                                      { using Tuple::Tuple; };
 
     struct PeerFailed       : Tuple<std::string>                               { using Tuple::Tuple; };
     struct PeerClosed       : Tuple<>                                          { using Tuple::Tuple; };
@@ -65,6 +67,7 @@ struct Spectacle
 
         OutputFailed,
         OutputClosed,
+        OutputExpectContinue,
 
         PeerFailed,
         PeerClosed,
@@ -90,7 +93,7 @@ struct Spectacle
         interconnect();
     }
 
-    Spectacle()
+    Spectacle(www::http::server::Settings settings = {})
     {
         Manager* manager = testManager();
         net::Host<> netHost = *manager->createService<net::Host<>>();
@@ -101,7 +104,7 @@ struct Spectacle
         utils::S2f accepted = netServer->accepted();
 
         _peer = *netHost->streamClient()->connect(*netServer->localEndpoint());
-        _target = *wwwFactory->httpServerChannel(*accepted);
+        _target = *wwwFactory->httpServerChannel(*accepted, std::move(settings));
 
         interconnect();
     }
@@ -169,6 +172,11 @@ struct Spectacle
                 _actions.emplace_back(OutputClosed{});
             };
 
+            output->expectContinue() += _sol * [&]()
+            {
+                _actions.emplace_back(OutputExpectContinue{});
+            };
+
             _ios.emplace_back(IO{std::move(input), std::move(output)});
         };
 
@@ -334,6 +342,53 @@ TEST(module_www, server_bigUri)
     PLAY_2_FAIL("METH " + std::string(8193, 'x'), request::TooBigUri, "HTTP/1.1 414 URI Too Long\r\nConnection: close\r\n\r\n");
 }
 
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_limits)
+{
+    www::http::server::Settings tight{};
+    tight.maxUriSize = 16;
+    tight.maxHeadersCount = 2;
+
+    {
+        Spectacle spectacle{tight};
+        spectacle._peer->send("GET /" + std::string(16, 'x') + " HTTP/1.1\r\n\r\n");
+        spectacle.play();
+
+        CHECK_IO();
+        CHECK_FAIL(request::TooBigUri);
+        CHECK_PEERDATA("HTTP/1.1 414 URI Too Long\r\nConnection: close\r\n\r\n");
+    }
+
+    {
+        Spectacle spectacle{tight};
+        spectacle._peer->send("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n");
+        spectacle.play();
+
+        CHECK_IO();
+        CHECK_FAIL(request::TooBigHeaders);
+        CHECK_PEERDATA("HTTP/1.1 431 Request Header Fields Too Large\r\nConnection: close\r\n\r\n");
+    }
+
+    www::http::server::Settings wide{};
+    wide.maxUriSize = 65536;
+    wide.maxHeaderKeySize = 256;
+
+    {
+        std::string uri = "/" + std::string(20000, 'x');
+        std::string key = "X-" + std::string(100, 'k');
+
+        Spectacle spectacle{wide};
+        spectacle._peer->send("GET " + uri + " HTTP/1.1\r\n" + key + ": v\r\n\r\n");
+        spectacle.play();
+
+        CHECK_IO();
+        ASSERT_TRUE(spectacle.has<Spectacle::InputFirstLine>());
+        EXPECT_EQ(spectacle.get<Spectacle::InputFirstLine>().get<1>(), uri);
+        ASSERT_TRUE(spectacle.has<Spectacle::InputHeaders>());
+        EXPECT_EQ(spectacle.get<Spectacle::InputHeaders>().get<0>().front().key.get<www::http::header::KeyAny>(), key);
+    }
+}
+
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
 TEST(module_www, server_bigVersion)
 {
@@ -392,29 +447,965 @@ TEST(module_www, server_badHeaderValue)
 }
 
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-TEST(module_www, server_bodyUntilClose)
+TEST(module_www, server_ctlInHeader)
 {
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nh: va\x01lue\r\n\r\n",                            request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nh: va\nlue\r\n\r\n",                              request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nh: " + std::string(40, 'v') + "\x7f\r\n\r\n",     request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    PLAY_2_FAIL("GET u\x1bri HTTP/1.1\r\n\r\n",                                        request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_headers)
+{
+    for(std::size_t split : {0, 20, 31, 48})
+    {
+        std::string req = "GET uri HTTP/1.1\r\nHost: example\r\nX-Custom:  v1 \t \r\nX-Folded: a\r\n b\r\nX-Empty:\r\n\r\n";
+
+        Spectacle spectacle;
+        if(split)
+        {
+            spectacle._peer->send(req.substr(0, split));
+            spectacle.play();
+            spectacle._peer->send(req.substr(split));
+        }
+        else
+            spectacle._peer->send(req);
+        spectacle.play();
+
+        CHECK_IO();
+        ASSERT_TRUE(spectacle.has<Spectacle::InputHeaders>());
+
+        primitives::List<www::http::Header> headers;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::InputHeaders>())
+                for(const www::http::Header& h : a.get<Spectacle::InputHeaders>().get<0>())
+                    headers.push_back(h);
+
+        ASSERT_EQ(headers.size(), 4u);
+
+        ASSERT_TRUE(headers[0].key.holds<www::http::header::KeyRecognized>());
+        EXPECT_EQ(headers[0].key.get<www::http::header::KeyRecognized>(), www::http::header::KeyRecognized::Host);
+        EXPECT_EQ(headers[0].value, "example");
+
+        ASSERT_TRUE(headers[1].key.holds<www::http::header::KeyAny>());
+        EXPECT_EQ(headers[1].key.get<www::http::header::KeyAny>(), "X-Custom");
+        EXPECT_EQ(headers[1].value, "v1");
+
+        EXPECT_EQ(headers[2].key.get<www::http::header::KeyAny>(), "X-Folded");
+        EXPECT_EQ(headers[2].value, "a b");
+
+        EXPECT_EQ(headers[3].key.get<www::http::header::KeyAny>(), "X-Empty");
+        EXPECT_EQ(headers[3].value, "");
+    }
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_headersBatch)
+{
+    // one segment per header line still gives one delivery
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\n\r\n[this is a body]");
+    spectacle._peer->send("GET uri HTTP/1.1\r\n");
     spectacle.play();
-    spectacle._peer->close();
+    for(char c : std::string{"abcde"})
+    {
+        spectacle._peer->send(std::string{"X-"} + c + ": " + c + "\r\n");
+        spectacle.play();
+    }
+    spectacle._peer->send("\r\n");
     spectacle.play();
 
     CHECK_IO();
-    CHECK_INPUTDATA("[this is a body]");
+
+    std::size_t deliveries{};
+    for(const Spectacle::Action& a : spectacle._actions)
+    {
+        if(a.holds<Spectacle::InputHeaders>())
+        {
+            ++deliveries;
+            EXPECT_EQ(a.get<Spectacle::InputHeaders>().get<0>().size(), 5u);
+            EXPECT_TRUE(a.get<Spectacle::InputHeaders>().get<1>());
+        }
+    }
+    EXPECT_EQ(deliveries, 1u);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_headInOneSegment)
+{
+    // whole head in one segment takes the single pass parser, split one goes through the incremental states
+    for(std::string req : {
+        "GET /a?b HTTP/1.1\r\nHost: x\r\nContent-Length: 3\r\n\r\nabc",
+        "POST /p HTTP/1.0\r\nX-A: 1\r\n  continued\r\nX-B:2\r\n\r\n",
+        "GET u\x1bri HTTP/1.1\r\n\r\n",
+        "BREW / HTTP/1.1\r\n\r\n",
+        "GET / HTTP/9.9\r\n\r\n",
+        "GET / HTTP/1.1\r\nBad Key: v\r\n\r\n"})
+    {
+        Spectacle whole;
+        whole._peer->send(req);
+        whole.play();
+
+        Spectacle split;
+        split._peer->send(req.substr(0, 1));
+        split.play();
+        split._peer->send(req.substr(1));
+        split.play();
+
+        EXPECT_EQ(whole._actions, split._actions) << req;
+    }
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_pipelining)
+{
+    www::http::server::Settings settings{};
+    settings.maxInFlight = 2;
+
+    Spectacle spectacle{settings};
+    spectacle._peer->send("GET /1 HTTP/1.1\r\n\r\nGET /2 HTTP/1.1\r\n\r\nGET /3 HTTP/1.1\r\n\r\n");
+    spectacle.play();
+
+    // third one waits for a room
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+
+    auto peerData = [&]
+    {
+        std::string res;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::PeerData>())
+                res += a.get<Spectacle::PeerData>().get<0>().toString();
+        return res;
+    };
+
+    // completed out of order, held until the first one
+    spectacle._ios[1]._output->data("second", true);
+    spectacle._ios[1]._output->done();
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+    ASSERT_EQ(peerData(), "");
+
+    spectacle._ios[0]._output->data("first", true);
+    spectacle._ios[0]._output->done();
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 3u);
+    ASSERT_EQ(peerData(), "firstsecond");
+
+    std::size_t firstLines{};
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::InputFirstLine>())
+            EXPECT_EQ(a.get<Spectacle::InputFirstLine>().get<1>(), "/" + std::to_string(++firstLines));
+    ASSERT_EQ(firstLines, 3u);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_slowReader)
+{
+    www::http::server::Settings settings{};
+    settings.outputHighWatermark = 256 * 1024;
+    settings.outputLowWatermark = 64 * 1024;
+
+    Spectacle spectacle{settings};
+    spectacle._peer->send("GET / HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+
+    www::http::server::Response<>& output = spectacle._ios[0]._output;
+
+    bool paused{};
+    output->paused() += spectacle._sol * [&]{paused = true;};
+    output->resumed() += spectacle._sol * [&]{paused = false;};
+
+    // reader stalls, producer honours the pause
+    spectacle._peer->stopReceive();
+
+    constexpr std::size_t chunkSize = 16 * 1024;
+    std::size_t produced{};
+    for(std::size_t i{}; i<4096 && !paused; ++i)
+    {
+        output->data(std::string(chunkSize, 'x'), false);
+        produced += chunkSize;
+        poll::timeout(std::chrono::milliseconds{1}).wait();
+    }
+    ASSERT_TRUE(paused);
+
+    // nothing more is taken while stalled, the overshoot is the chunk that crossed the high watermark
+    for(std::size_t i{}; i<20; ++i)
+    {
+        www::http::server::Stats stats = *spectacle._target->stats();
+        EXPECT_GT(stats.outputQueued, 0u);
+        EXPECT_LE(stats.outputQueued, settings.outputHighWatermark + chunkSize);
+        poll::timeout(std::chrono::milliseconds{1}).wait();
+    }
+    EXPECT_TRUE(paused);
+
+    // reader wakes up, output drains below the low watermark
+    spectacle._peer->startReceive();
+    for(std::size_t i{}; i<10000 && paused; ++i)
+        poll::timeout(std::chrono::milliseconds{1}).wait();
+    ASSERT_FALSE(paused);
+
+    output->data(std::string(chunkSize, 'y'), true);
+    produced += chunkSize;
+    output->done();
+    spectacle.play();
+
+    std::size_t received{};
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().size();
+    EXPECT_EQ(received, produced);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_slowReaderResume)
+{
+    www::http::server::Settings settings{};
+    settings.outputHighWatermark = 256 * 1024;
+    settings.outputLowWatermark = 64 * 1024;
+
+    Spectacle spectacle{settings};
+    spectacle._peer->send("GET /1 HTTP/1.1\r\n\r\nGET /2 HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+
+    www::http::server::Response<>& output = spectacle._ios[0]._output;
+
+    bool paused{};
+    bool finished{};
+    output->paused() += spectacle._sol * [&]{paused = true;};
+
+    // the producer finishes right in the signal, the response is released meanwhile
+    output->resumed() += spectacle._sol * [&]
+    {
+        paused = false;
+        output->data("tail", true);
+        output->done();
+        finished = true;
+    };
+
+    spectacle._peer->stopReceive();
+
+    constexpr std::size_t chunkSize = 16 * 1024;
+    std::size_t produced{};
+    for(std::size_t i{}; i<4096 && !paused; ++i)
+    {
+        output->data(std::string(chunkSize, 'x'), false);
+        produced += chunkSize;
+        poll::timeout(std::chrono::milliseconds{1}).wait();
+    }
+    ASSERT_TRUE(paused);
+
+    spectacle._peer->startReceive();
+    for(std::size_t i{}; i<10000 && !finished; ++i)
+        poll::timeout(std::chrono::milliseconds{1}).wait();
+    ASSERT_TRUE(finished);
+    produced += 4;
+
+    // the next one goes on as usual
+    spectacle._ios[1]._output->data("next", true);
+    spectacle._ios[1]._output->done();
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    ASSERT_EQ(received.size(), produced + 4);
+    EXPECT_EQ(received.substr(produced - 4), "tailnext");
+    EXPECT_FALSE(spectacle.has<Spectacle::Failed>());
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseHead)
+{
+    Spectacle spectacle;
+    spectacle._peer->send("GET / HTTP/1.1\r\n\r\nGET / HTTP/1.0\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+
+    primitives::List<www::http::Header> headers(2);
+    headers[0].key = www::http::header::KeyRecognized::Content_Length;
+    headers[0].value = "2";
+    headers[1].key = www::http::header::KeyAny{"X-Custom"};
+    headers[1].value = "v";
+
+    // standard reason phrase from the table
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[0]._output->headers(headers, true);
+    spectacle._ios[0]._output->data("ok", true);
+    spectacle._ios[0]._output->done();
+
+    // custom one
+    spectacle._ios[1]._output->firstLine(www::http::firstLine::Version::HTTP_1_0, 299, "Fine");
+    spectacle._ios[1]._output->headers({}, true);
+    spectacle._ios[1]._output->done();
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    EXPECT_EQ(received, "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nX-Custom: v\r\n\r\nok" "HTTP/1.0 299 Fine\r\nConnection: close\r\n\r\n");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseSplitting)
+{
+    Spectacle spectacle;
+    spectacle._peer->send("GET / HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyAny{"X-Custom"};
+    headers[0].value = "v\r\n\r\ninjected";
+
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[0]._output->headers(headers, true);
+    spectacle.play();
+
+    ASSERT_TRUE(spectacle.has<Spectacle::Failed>());
+    EXPECT_EQ(spectacle.get<Spectacle::Failed>().get<0>(), "dci::idl::gen::www::http::error::response::BadResponse{}");
+    EXPECT_FALSE(spectacle.has<Spectacle::PeerData>());
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseDate)
+{
+    www::http::server::Settings settings{};
+    settings.addDate = true;
+
+    Spectacle spectacle{settings};
+    spectacle._peer->send("GET / HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 204, "");
+    spectacle._ios[0]._output->headers({}, true);
+    spectacle._ios[0]._output->done();
+
+    // own one is kept alone
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyRecognized::Date;
+    headers[0].value = "Sun, 06 Nov 1994 08:49:37 GMT";
+    spectacle._ios[1]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 204, "");
+    spectacle._ios[1]._output->headers(headers, true);
+    spectacle._ios[1]._output->done();
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    // status line, the 37 bytes of date line, empty line
+    std::string_view first = std::string_view{received}.substr(0, 25 + 37 + 2);
+    ASSERT_EQ(first.substr(0, 31), "HTTP/1.1 204 No Content\r\nDate: ");
+    ASSERT_EQ(first.substr(25 + 37 - 6), " GMT\r\n\r\n");
+
+    EXPECT_EQ(received.substr(first.size()), "HTTP/1.1 204 No Content\r\nDate: Sun, 06 Nov 1994 08:49:37 GMT\r\n\r\n");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseCompress)
+{
+    www::http::server::Settings settings{};
+    settings.compress = true;
+
+    std::string content;
+    for(std::size_t i{}; i<5000; ++i)
+        content += static_cast<char>('a' + i % 7);
+
+    auto roundtrip = [&](std::string acceptEncoding, std::string_view version = "HTTP/1.1")
+    {
+        Spectacle spectacle{settings};
+        spectacle._peer->send("GET / " + std::string{version} + "\r\nAccept-Encoding: " + acceptEncoding + "\r\n\r\n");
+        spectacle.play();
+        EXPECT_EQ(spectacle._ios.size(), 1u);
+
+        primitives::List<www::http::Header> headers(2);
+        headers[0].key = www::http::header::KeyRecognized::Content_Type;
+        headers[0].value = "text/plain";
+        headers[1].key = www::http::header::KeyRecognized::Content_Length;
+        headers[1].value = std::to_string(content.size());
+
+        spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+        spectacle._ios[0]._output->headers(headers, true);
+        spectacle._ios[0]._output->data(content.substr(0, 3000), false);
+        spectacle._ios[0]._output->data(content.substr(3000), true);
+        spectacle._ios[0]._output->done();
+        spectacle.play();
+
+        std::string received;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::PeerData>())
+                received += a.get<Spectacle::PeerData>().get<0>().toString();
+        return received;
+    };
+
+    // the module decodes what it encoded
+    auto decoded = [&](std::string_view coding, std::string_view chunkedBody)
+    {
+        Spectacle spectacle;
+        spectacle._peer->send("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Encoding: " + std::string{coding} + "\r\n\r\n" + std::string{chunkedBody});
+        spectacle.play();
+
+        std::string res;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::InputData>())
+                res += a.get<Spectacle::InputData>().get<0>().toString();
+        return res;
+    };
+
+    for(std::string coding : {"zstd", "br", "gzip"})
+    {
+        std::string received = roundtrip("identity, " + coding);
+        std::size_t headEnd = received.find("\r\n\r\n");
+        ASSERT_NE(headEnd, std::string::npos);
+
+        std::string head = received.substr(0, headEnd + 4);
+        EXPECT_NE(head.find("Content-Encoding: " + coding + "\r\n"), std::string::npos);
+        EXPECT_NE(head.find("Transfer-Encoding: chunked\r\n"), std::string::npos);
+        EXPECT_NE(head.find("Vary: Accept-Encoding\r\n"), std::string::npos);
+        EXPECT_EQ(head.find("Content-Length"), std::string::npos);
+
+        std::string body = received.substr(headEnd + 4);
+        EXPECT_LT(body.size(), content.size());
+        EXPECT_EQ(decoded(coding, body), content);
+    }
+
+    // refused and preferred ones
+    EXPECT_NE(roundtrip("br;q=0, gzip;q=0.5").find("Content-Encoding: gzip\r\n"), std::string::npos);
+    EXPECT_EQ(roundtrip("gzip;q=0").find("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nVary: Accept-Encoding\r\nContent-Length: 5000\r\n\r\n"), 0u);
+
+    // no chunks for an HTTP/1.0 client, the body goes as is
+    EXPECT_EQ(roundtrip("gzip", "HTTP/1.0").find("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nVary: Accept-Encoding\r\nContent-Length: 5000\r\nConnection: close\r\n\r\n"), 0u);
 }
 
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
-TEST(module_www, server_bodyUntilClose2)
+TEST(module_www, server_responseChunked)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nConnection:  close \r\n\r\n[this is a body]");
+    spectacle._peer->send("GET / HTTP/1.1\r\n\r\nHEAD / HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 3u);
+
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyRecognized::Content_Type;
+    headers[0].value = "text/plain";
+
+    // length is unknown, body is streamed
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[0]._output->headers(headers, true);
+    spectacle._ios[0]._output->data("hello", false);
+    spectacle._ios[0]._output->data("", false);
+    spectacle._ios[0]._output->data(" world", true);
+    spectacle._ios[0]._output->done();
+
+    // no body for HEAD
+    spectacle._ios[1]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[1]._output->headers(headers, true);
+    spectacle._ios[1]._output->done();
+
+    // finished by done
+    spectacle._ios[2]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[2]._output->headers({}, true);
+    spectacle._ios[2]._output->data("x", false);
+    spectacle._ios[2]._output->done();
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    EXPECT_EQ(received,
+              "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n"
+              "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n\r\n"
+              "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n1\r\nx\r\n0\r\n\r\n");
+    EXPECT_FALSE(spectacle.has<Spectacle::PeerClosed>());
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseChunked10)
+{
+    Spectacle spectacle;
+    spectacle._peer->send("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+
+    // HTTP/1.1 status line with unknown length, the HTTP/1.0 peer gets the body until the close
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[0]._output->headers({}, true);
+    spectacle._ios[0]._output->data("hello", false);
+    spectacle._ios[0]._output->data(" world", true);
+    spectacle._ios[0]._output->done();
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    EXPECT_EQ(received, "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nhello world");
+    EXPECT_TRUE(spectacle.has<Spectacle::PeerClosed>());
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseFile)
+{
+    std::string content;
+    for(std::size_t i{}; i<1024*1024; ++i)
+        content += static_cast<char>('a' + i % 23);
+
+    char path[] = "/tmp/dci-www-test-XXXXXX";
+    int fd = ::mkstemp(path);
+    ASSERT_LE(0, fd);
+    ::unlink(path);
+    ASSERT_EQ(::write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+
+    Spectacle spectacle;
+    spectacle._peer->send("GET / HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+
+    // more than the output high watermark, read as the peer takes it
+    std::size_t offset = 100;
+    std::size_t size = content.size() - 200;
+
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyRecognized::Content_Length;
+    headers[0].value = std::to_string(size + 4);
+
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+    spectacle._ios[0]._output->headers(headers, true);
+    spectacle._ios[0]._output->file(fd, offset, size, false);
+    spectacle._ios[0]._output->data("tail", true);
+    spectacle._ios[0]._output->done();
+    ::close(fd);
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    std::string head = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(size + 4) + "\r\n\r\n";
+    ASSERT_EQ(received.size(), head.size() + size + 4);
+    EXPECT_EQ(received.substr(0, head.size()), head);
+    EXPECT_TRUE(received.substr(head.size(), size) == content.substr(offset, size));
+    EXPECT_EQ(received.substr(head.size() + size), "tail");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseCompressCached)
+{
+    www::http::server::Settings settings{};
+    settings.compress = true;
+
+    std::string content;
+    for(std::size_t i{}; i<20000; ++i)
+        content += "abcdefghijklmnopqrstuvwxyz0123456789"[i * 7 % 36];
+
+    auto serve = [&]
+    {
+        Spectacle spectacle{settings};
+        spectacle._peer->send("GET /app.js HTTP/1.1\r\nAccept-Encoding: br\r\n\r\n");
+        spectacle.play();
+        EXPECT_EQ(spectacle._ios.size(), 1u);
+
+        primitives::List<www::http::Header> headers(1);
+        headers[0].key = www::http::header::KeyRecognized::Content_Type;
+        headers[0].value = "text/javascript";
+
+        spectacle._ios[0]._output->cacheable();
+        spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+        spectacle._ios[0]._output->headers(headers, true);
+        spectacle._ios[0]._output->data(content.substr(0, 12345), false);
+        spectacle._ios[0]._output->data(content.substr(12345), true);
+        spectacle._ios[0]._output->done();
+        spectacle.play();
+
+        std::string received;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::PeerData>())
+                received += a.get<Spectacle::PeerData>().get<0>().toString();
+        return received;
+    };
+
+    std::string first = serve();
+    std::string second = serve();
+
+    EXPECT_NE(first.find("Content-Encoding: br\r\n"), std::string::npos);
+    EXPECT_EQ(first, second);
+
+    // whole body in one chunk, decodable by the module itself
+    Spectacle spectacle;
+    spectacle._peer->send("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Encoding: br\r\n\r\n" + first.substr(first.find("\r\n\r\n") + 4));
+    spectacle.play();
+
+    std::string decoded;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::InputData>())
+            decoded += a.get<Spectacle::InputData>().get<0>().toString();
+    EXPECT_EQ(decoded, content);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseNotModified)
+{
+    Spectacle spectacle;
+    spectacle._peer->send(
+        "GET / HTTP/1.1\r\nIf-None-Match: \"v2\", W/\"v1\"\r\n\r\n"
+        "GET / HTTP/1.1\r\nIf-Modified-Since: Sun, 06 Nov 1994 08:49:37 GMT\r\n\r\n"
+        "GET / HTTP/1.1\r\nIf-Modified-Since: Sun, 06 Nov 1994 08:49:36 GMT\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 3u);
+
+    std::size_t notModified{};
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyRecognized::Content_Length;
+    headers[0].value = "2";
+
+    // producer that does not look at the outcome, all of it is ignored after 304
+    for(std::size_t i{}; i<3; ++i)
+    {
+        www::http::server::Response<>& output = spectacle._ios[i]._output;
+        output->notModified() += spectacle._sol * [&]{++notModified;};
+
+        output->validators(1 == i ? "" : "\"v1\"", 0 == i ? 0 : 784111777);
+        output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+        output->headers(headers, true);
+        output->data("ok", true);
+        output->done();
+    }
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    EXPECT_EQ(notModified, 2u);
+    EXPECT_EQ(received,
+        "HTTP/1.1 304 Not Modified\r\nETag: \"v1\"\r\n\r\n"
+        "HTTP/1.1 304 Not Modified\r\n\r\n"
+        "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nETag: \"v1\"\r\nLast-Modified: Sun, 06 Nov 1994 08:49:37 GMT\r\n\r\nok");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_responseRanges)
+{
+    std::string content;
+    for(std::size_t i{}; i<1000; ++i)
+        content += static_cast<char>('a' + i % 26);
+
+    char path[] = "/tmp/dci-www-test-XXXXXX";
+    int fd = ::mkstemp(path);
+    ASSERT_LE(0, fd);
+    ::unlink(path);
+    ASSERT_EQ(::write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+
+    Spectacle spectacle;
+    spectacle._peer->send(
+        "GET / HTTP/1.1\r\nRange: bytes=10-19\r\n\r\n"
+        "GET / HTTP/1.1\r\nRange: bytes=-5, 0-2\r\n\r\n"
+        "GET / HTTP/1.1\r\nRange: bytes=2000-\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 3u);
+
+    primitives::List<www::http::Header> headers(2);
+    headers[0].key = www::http::header::KeyRecognized::Content_Type;
+    headers[0].value = "text/plain";
+    headers[1].key = www::http::header::KeyRecognized::Content_Length;
+    headers[1].value = "1000";
+
+    // whole representation each time, by a file or by pieces
+    for(std::size_t i{}; i<3; ++i)
+    {
+        www::http::server::Response<>& output = spectacle._ios[i]._output;
+        output->ranges();
+        output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+        output->headers(headers, true);
+        if(!i)
+            output->file(fd, 0, content.size(), true);
+        else
+        {
+            output->data(content.substr(0, 500), false);
+            output->data(content.substr(500), true);
+        }
+        output->done();
+    }
+    ::close(fd);
+    spectacle.play();
+
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+
+    std::string single =
+        "HTTP/1.1 206 Partial Content\r\nAccept-Ranges: bytes\r\nContent-Type: text/plain\r\n"
+        "Content-Range: bytes 10-19/1000\r\nContent-Length: 10\r\n\r\n" + content.substr(10, 10);
+    ASSERT_EQ(received.substr(0, single.size()), single);
+    received.erase(0, single.size());
+
+    std::string_view multiHead = "HTTP/1.1 206 Partial Content\r\nAccept-Ranges: bytes\r\nContent-Type: multipart/byteranges; boundary=";
+    ASSERT_EQ(received.substr(0, multiHead.size()), multiHead);
+    std::string boundary = received.substr(multiHead.size(), received.find("\r\n", multiHead.size()) - multiHead.size());
+
+    // sorted by position
+    std::string parts =
+        "\r\n--" + boundary + "\r\nContent-Type: text/plain\r\nContent-Range: bytes 0-2/1000\r\n\r\n" + content.substr(0, 3) +
+        "\r\n--" + boundary + "\r\nContent-Type: text/plain\r\nContent-Range: bytes 995-999/1000\r\n\r\n" + content.substr(995) +
+        "\r\n--" + boundary + "--\r\n";
+    std::string multi = std::string{multiHead} + boundary + "\r\nContent-Length: " + std::to_string(parts.size()) + "\r\n\r\n" + parts;
+    ASSERT_EQ(received.substr(0, multi.size()), multi);
+    received.erase(0, multi.size());
+
+    EXPECT_EQ(received, "HTTP/1.1 416 Range Not Satisfiable\r\nAccept-Ranges: bytes\r\nContent-Range: bytes */1000\r\nContent-Length: 0\r\n\r\n");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_expectContinue)
+{
+    www::http::server::Settings settings{};
+    settings.deferContinue = true;
+
+    // the client does not wait, the body is in the socket already
+    Spectacle spectacle{settings};
+    spectacle._peer->send(
+        "POST /a HTTP/1.1\r\nExpect: 100-continue\r\nContent-Length: 4\r\n\r\nbody"
+        "POST /b HTTP/1.1\r\nExpect: 100-continue\r\nContent-Length: 5\r\n\r\nxxxxx"
+        "GET /c HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+    EXPECT_TRUE(spectacle.has<Spectacle::OutputExpectContinue>());
+    EXPECT_FALSE(spectacle.has<Spectacle::InputData>());
+    EXPECT_FALSE(spectacle.has<Spectacle::PeerData>());
+
+    // accepted
+    spectacle._ios[0]._output->continueBody();
+    spectacle.play();
+    ASSERT_TRUE(spectacle.has<Spectacle::InputData>());
+    EXPECT_EQ(spectacle.get<Spectacle::InputData>().get<0>().toString(), "body");
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyRecognized::Content_Length;
+    headers[0].value = "0";
+
+    spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 204, "");
+    spectacle._ios[0]._output->headers({}, true);
+    spectacle._ios[0]._output->done();
+
+    // rejected, the connection stays for the next request
+    spectacle._ios[1]._output->rejectBody(true);
+    spectacle._ios[1]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 413, "");
+    spectacle._ios[1]._output->headers(headers, true);
+    spectacle._ios[1]._output->done();
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 3u);
+
+    spectacle._ios[2]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 204, "");
+    spectacle._ios[2]._output->headers({}, true);
+    spectacle._ios[2]._output->done();
+    spectacle.play();
+
+    std::size_t inputData{};
+    std::string received;
+    for(const Spectacle::Action& a : spectacle._actions)
+    {
+        inputData += a.holds<Spectacle::InputData>() && !a.get<Spectacle::InputData>().get<0>().empty() ? 1 : 0;
+        if(a.holds<Spectacle::PeerData>())
+            received += a.get<Spectacle::PeerData>().get<0>().toString();
+    }
+
+    EXPECT_EQ(inputData, 1u);
+    EXPECT_EQ(received,
+        "HTTP/1.1 100 Continue\r\n\r\n"
+        "HTTP/1.1 204 No Content\r\n\r\n"
+        "HTTP/1.1 413 Content Too Large\r\nContent-Length: 0\r\n\r\n"
+        "HTTP/1.1 204 No Content\r\n\r\n");
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_keepAlive)
+{
+    auto peerData = [](const Spectacle& spectacle)
+    {
+        std::string res;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::PeerData>())
+                res += a.get<Spectacle::PeerData>().get<0>().toString();
+        return res;
+    };
+
+    primitives::List<www::http::Header> headers(1);
+    headers[0].key = www::http::header::KeyRecognized::Content_Length;
+    headers[0].value = "2";
+
+    // HTTP/1.0 asks for it, the pipelined one after close is not dispatched
+    {
+        Spectacle spectacle;
+        spectacle._peer->send("GET /a HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+        spectacle.play();
+        ASSERT_EQ(spectacle._ios.size(), 1u);
+
+        spectacle._ios[0]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+        spectacle._ios[0]._output->headers(headers, true);
+        spectacle._ios[0]._output->data("ok", true);
+        spectacle._ios[0]._output->done();
+        spectacle.play();
+        EXPECT_FALSE(spectacle.has<Spectacle::PeerClosed>());
+
+        spectacle._peer->send("GET /b HTTP/1.1\r\nConnection: Close\r\n\r\nGET /c HTTP/1.1\r\n\r\n");
+        spectacle.play();
+        ASSERT_EQ(spectacle._ios.size(), 2u);
+
+        spectacle._ios[1]._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 204, "");
+        spectacle._ios[1]._output->headers({}, true);
+        spectacle._ios[1]._output->done();
+        spectacle.play();
+
+        ASSERT_EQ(spectacle._ios.size(), 2u);
+        EXPECT_TRUE(spectacle.has<Spectacle::PeerClosed>());
+        EXPECT_EQ(peerData(spectacle),
+            "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: keep-alive\r\n\r\nok"
+            "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n");
+    }
+
+    // the last of maxRequests closes
+    {
+        www::http::server::Settings settings{};
+        settings.maxRequests = 2;
+
+        Spectacle spectacle{settings};
+        spectacle._peer->send("GET /1 HTTP/1.1\r\n\r\nGET /2 HTTP/1.1\r\n\r\nGET /3 HTTP/1.1\r\n\r\n");
+        spectacle.play();
+        ASSERT_EQ(spectacle._ios.size(), 2u);
+
+        for(Spectacle::IO& io : spectacle._ios)
+        {
+            io._output->firstLine(www::http::firstLine::Version::HTTP_1_1, 200, "");
+            io._output->headers(headers, true);
+            io._output->data("ok", true);
+            io._output->done();
+        }
+        spectacle.play();
+
+        ASSERT_EQ(spectacle._ios.size(), 2u);
+        EXPECT_TRUE(spectacle.has<Spectacle::PeerClosed>());
+        EXPECT_EQ(peerData(spectacle),
+            "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok"
+            "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok");
+    }
+
+    // idle one goes silently
+    {
+        www::http::server::Settings settings{};
+        settings.idleTimeout = 20;
+
+        Spectacle spectacle{settings};
+        for(std::size_t i{}; i<1000 && !spectacle.has<Spectacle::PeerClosed>(); ++i)
+            poll::timeout(std::chrono::milliseconds{1}).wait();
+
+        EXPECT_TRUE(spectacle.has<Spectacle::PeerClosed>());
+        EXPECT_FALSE(spectacle.has<Spectacle::PeerData>());
+    }
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_slowClient)
+{
+    www::http::server::Settings settings{};
+    settings.headTimeout = 20;
+    settings.minBodyRate = 1000;
+    settings.bodyRateWindow = 20;
+
+    // head trickling in, body far below the rate
+    for(std::string req : {"GET / HTTP/1.1\r\nHost: x", "POST / HTTP/1.1\r\nContent-Length: 100\r\n\r\nab"})
+    {
+        Spectacle spectacle{settings};
+        spectacle._peer->send(req);
+
+        for(std::size_t i{}; i<1000 && !spectacle.has<Spectacle::PeerClosed>(); ++i)
+            poll::timeout(std::chrono::milliseconds{1}).wait();
+
+        CHECK_IO();
+        CHECK_FAIL(request::Timeout);
+        CHECK_PEERDATA("HTTP/1.1 408 Request Timeout\r\nConnection: close\r\n\r\n");
+    }
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyCredit)
+{
+    www::http::server::Settings settings{};
+    settings.bodyWindow = 4;
+
+    Spectacle spectacle{settings};
+    spectacle._peer->send("POST / HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789" "GET /next HTTP/1.1\r\n\r\n");
+    spectacle.play();
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+
+    auto inputData = [&]
+    {
+        std::string res;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::InputData>())
+                res += a.get<Spectacle::InputData>().get<0>().toString() + (a.get<Spectacle::InputData>().get<1>() ? "|" : ",");
+        return res;
+    };
+
+    // no more than granted, the next request is not read meanwhile
+    EXPECT_EQ(inputData(), "0123,");
+
+    spectacle._ios[0]._input->grant(3);
+    spectacle.play();
+    EXPECT_EQ(inputData(), "0123,456,");
+    EXPECT_FALSE(spectacle.has<Spectacle::InputDone>());
+    ASSERT_EQ(spectacle._ios.size(), 1u);
+
+    spectacle._ios[0]._input->grant(100);
+    spectacle.play();
+    EXPECT_EQ(inputData(), "0123,456,789||");
+    EXPECT_TRUE(spectacle.has<Spectacle::InputDone>());
+    ASSERT_EQ(spectacle._ios.size(), 2u);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyAbsent)
+{
+    // no Content-Length and no Transfer-Encoding, the request has no body and the next one follows
+    Spectacle spectacle;
+    spectacle._peer->send("GET uri HTTP/1.1\r\n\r\nGET uri2 HTTP/1.1\r\n\r\n[this is not a body]");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
 
     CHECK_IO();
-    CHECK_INPUTDATA("[this is a body]");
+    CHECK_INPUTDATA("");
+    ASSERT_EQ(spectacle._ios.size(), 3u);
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyAbsent2)
+{
+    // the connection closes after this one, the rest is never read
+    Spectacle spectacle;
+    spectacle._peer->send("GET uri HTTP/1.1\r\nConnection:  close \r\n\r\n[this is not a body]");
+    spectacle.play();
+
+    CHECK_IO();
+    ASSERT_TRUE(spectacle.has<Spectacle::InputData>());
+    EXPECT_EQ(spectacle.get<Spectacle::InputData>().get<0>(), Bytes{});
+    EXPECT_TRUE(spectacle.get<Spectacle::InputData>().get<1>());
+    EXPECT_TRUE(spectacle.has<Spectacle::InputDone>());
+    ASSERT_EQ(spectacle._ios.size(), 1u);
 }
 
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
@@ -434,7 +1425,7 @@ TEST(module_www, server_bodyByLength)
 TEST(module_www, server_bodyChunked)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n10\r\n[this is a body]\r\n0\r\nextra");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n10\r\n[this is a body]\r\n0\r\nX-Checksum: 1\r\n\r\nextra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -443,6 +1434,92 @@ TEST(module_www, server_bodyChunked)
     CHECK_INPUTDATA("[this is a body]");
 }
 
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyChunked3)
+{
+    std::string req = "POST uri HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+                      "A\r\n0123456789\r\n"
+                      "0000000b\r\nabcdefghijk\r\n"
+                      "1\r\n-\r\n"
+                      "0\r\n\r\n";
+
+    for(std::size_t split : {0, 70, 88})
+    {
+        Spectacle spectacle;
+        if(split)
+        {
+            spectacle._peer->send(req.substr(0, split));
+            spectacle.play();
+            spectacle._peer->send(req.substr(split));
+        }
+        else
+            spectacle._peer->send(req);
+        spectacle.play();
+
+        CHECK_IO();
+
+        std::string body;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::InputData>())
+                body += a.get<Spectacle::InputData>().get<0>().toString();
+
+        EXPECT_EQ(body, "0123456789abcdefghijk-");
+        EXPECT_TRUE(spectacle.has<Spectacle::InputDone>());
+    }
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyCaseInsensitive)
+{
+    {
+        Spectacle spectacle;
+        spectacle._peer->send("GET uri HTTP/1.1\r\ncontent-length: 16\r\n\r\n[this is a body]extra");
+        spectacle.play();
+        spectacle._peer->close();
+        spectacle.play();
+
+        CHECK_IO();
+        CHECK_INPUTDATA("[this is a body]");
+    }
+
+    {
+        Spectacle spectacle;
+        spectacle._peer->send("GET uri HTTP/1.1\r\nTRANSFER-ENCODING: Chunked\r\n\r\n10\r\n[this is a body]\r\n0\r\n\r\nextra");
+        spectacle.play();
+        spectacle._peer->close();
+        spectacle.play();
+
+        CHECK_IO();
+        CHECK_INPUTDATA("[this is a body]");
+    }
+}
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyChunkedPipelined)
+{
+    // trailer section and the final CRLF belong to the chunked body, the next request starts right after
+    for(const char* trailer : {"", "X-Checksum: 1\r\nX-Other: 2\r\n"})
+    {
+        Spectacle spectacle;
+        spectacle._peer->send(std::string{"POST /a HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+                                          "4\r\nbody\r\n"
+                                          "0\r\n"} + trailer + "\r\n"
+                              "GET /b HTTP/1.1\r\n\r\n");
+        spectacle.play();
+
+        CHECK_IO();
+        EXPECT_FALSE(spectacle.has<Spectacle::InputFailed>());
+        ASSERT_EQ(spectacle._ios.size(), 2u);
+
+        std::vector<std::string> uris;
+        for(const Spectacle::Action& a : spectacle._actions)
+            if(a.holds<Spectacle::InputFirstLine>())
+                uris.push_back(a.get<Spectacle::InputFirstLine>().get<1>());
+        EXPECT_EQ(uris, (std::vector<std::string>{"/a", "/b"}));
+        EXPECT_EQ(spectacle.get<Spectacle::InputData>().get<0>(), Bytes{"body"});
+    }
+}
+
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
 TEST(module_www, server_bodyChunked2)
 {
@@ -451,7 +1528,7 @@ TEST(module_www, server_bodyChunked2)
                           "3\r\n[th\r\n"
                           "7\r\nis is a\r\n"
                           "6\r\n body]\r\n"
-                          "0\r\n"
+                          "0\r\n\r\n"
                           "extra");
     spectacle.play();
     spectacle._peer->close();
@@ -478,6 +1555,20 @@ TEST(module_www, server_bodyCompress)
 }
 
 
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_bodyFraming)
+{
+    // no final chunked coding, the body could not be told from the next request
+    PLAY_2_FAIL("POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n"
+                "GET /smuggled HTTP/1.1\r\n\r\n", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    PLAY_2_FAIL("POST / HTTP/1.1\r\nTransfer-Encoding: chunked, gzip\r\n\r\n", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+
+    // Transfer-Encoding together with Content-Length, in any order
+    PLAY_2_FAIL("POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\nContent-Length: 5\r\n\r\n", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    PLAY_2_FAIL("POST / HTTP/1.1\r\nContent-Length: 5\r\nTransfer-Encoding: chunked\r\n\r\n", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+    PLAY_2_FAIL("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 5\r\n\r\n", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
+}
+
 /////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
 // echo -n "[this is a body]" | perl -MIO::Compress::RawDeflate -e 'undef $/; my ($in, $out) = (<>, undef); IO::Compress::RawDeflate::rawdeflate(\$in, \$out); print $out;' | hexdump -v -e '"\\" "x" 1/1 "%02X"'
 // \x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00
@@ -486,8 +1577,8 @@ TEST(module_www, server_bodyCompress)
 TEST(module_www, server_bodyDeflate)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nTransfer-Encoding: deflate\r\n\r\n"
-                          "\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\nTransfer-Encoding: chunked\r\n\r\n10\r\n"
+                          "\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00" "\r\n0\r\n\r\n" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -500,8 +1591,8 @@ TEST(module_www, server_bodyDeflate)
 TEST(module_www, server_bodyDeflate2)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\n\r\n"
-                          "\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\nContent-Length: 16\r\n\r\n"
+                          "\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -516,15 +1607,15 @@ TEST(module_www, server_bodyDeflate3)
     LOGD("the following log lines are caused by a test, these are not errors");
 
     // extra
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\nContent-Length: 36\r\n\r\n"
                 "\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad after middle
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\nContent-Length: 26\r\n\r\n"
                 "\x8B\x2E\xC9\xC8\x2C\x56 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: deflate\r\nContent-Length: 19\r\n\r\n"
                 "abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     LOGD("the end of the noisy test");
@@ -538,8 +1629,8 @@ TEST(module_www, server_bodyDeflate3)
 TEST(module_www, server_bodyGzip)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n"
-                          "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\x03\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00\xD0\x35\x3A\x02\x10\x00\x00\x00");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\nTransfer-Encoding: chunked\r\n\r\n22\r\n"
+                          "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\x03\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00\xD0\x35\x3A\x02\x10\x00\x00\x00" "\r\n0\r\n\r\n" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -552,8 +1643,8 @@ TEST(module_www, server_bodyGzip)
 TEST(module_www, server_bodyGzip2)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\n\r\n"
-                          "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\x03\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00\xD0\x35\x3A\x02\x10\x00\x00\x00");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\nContent-Length: 34\r\n\r\n"
+                          "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\x03\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00\xD0\x35\x3A\x02\x10\x00\x00\x00" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -568,15 +1659,15 @@ TEST(module_www, server_bodyGzip3)
     LOGD("the following log lines are caused by a test, these are not errors");
 
     // extra
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\nContent-Length: 54\r\n\r\n"
                 "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\x03\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85\xA4\xFC\x94\xCA\x58\x00\xD0\x35\x3A\x02\x10\x00\x00\x00 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad after middle
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\nContent-Length: 40\r\n\r\n"
                 "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\x03\x8B\x2E\xC9\xC8\x2C\x56\x00\xA2\x44\x85 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: gzip\r\nContent-Length: 19\r\n\r\n"
                 "abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     LOGD("the end of the noisy test");
@@ -590,8 +1681,8 @@ TEST(module_www, server_bodyGzip3)
 TEST(module_www, server_bodyZstd)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nTransfer-Encoding: zstd\r\n\r\n"
-                          "\x28\xB5\x2F\xFD\x04\x58\x81\x00\x00\x5B\x74\x68\x69\x73\x20\x69\x73\x20\x61\x20\x62\x6F\x64\x79\x5D\xBB\xDF\xC6\x39");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\nTransfer-Encoding: chunked\r\n\r\n1d\r\n"
+                          "\x28\xB5\x2F\xFD\x04\x58\x81\x00\x00\x5B\x74\x68\x69\x73\x20\x69\x73\x20\x61\x20\x62\x6F\x64\x79\x5D\xBB\xDF\xC6\x39" "\r\n0\r\n\r\n" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -604,8 +1695,8 @@ TEST(module_www, server_bodyZstd)
 TEST(module_www, server_bodyZstd2)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\n\r\n"
-                          "\x28\xB5\x2F\xFD\x04\x58\x81\x00\x00\x5B\x74\x68\x69\x73\x20\x69\x73\x20\x61\x20\x62\x6F\x64\x79\x5D\xBB\xDF\xC6\x39");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\nContent-Length: 29\r\n\r\n"
+                          "\x28\xB5\x2F\xFD\x04\x58\x81\x00\x00\x5B\x74\x68\x69\x73\x20\x69\x73\x20\x61\x20\x62\x6F\x64\x79\x5D\xBB\xDF\xC6\x39" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -620,15 +1711,15 @@ TEST(module_www, server_bodyZstd3)
     LOGD("the following log lines are caused by a test, these are not errors");
 
     // extra
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\nContent-Length: 49\r\n\r\n"
                 "\x28\xB5\x2F\xFD\x04\x58\x81\x00\x00\x5B\x74\x68\x69\x73\x20\x69\x73\x20\x61\x20\x62\x6F\x64\x79\x5D\xBB\xDF\xC6\x39 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad after middle
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\nContent-Length: 35\r\n\r\n"
                 "\x28\xB5\x2F\xFD\x04\x58\x81\x00\x00\x5B\x74\x68\x69\x73\x20 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: zstd\r\nContent-Length: 19\r\n\r\n"
                 "abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     LOGD("the end of the noisy test");
@@ -642,8 +1733,8 @@ TEST(module_www, server_bodyZstd3)
 TEST(module_www, server_bodyBrotli)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nTransfer-Encoding: br\r\n\r\n"
-                          "\x1F\x0F\x00\xF8\xA5\xB6\xBA\x52\x10\x45\x1A\x29\x17\x66\xDA\x29\x52");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: br\r\nTransfer-Encoding: chunked\r\n\r\n11\r\n"
+                          "\x1F\x0F\x00\xF8\xA5\xB6\xBA\x52\x10\x45\x1A\x29\x17\x66\xDA\x29\x52" "\r\n0\r\n\r\n" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -656,8 +1747,8 @@ TEST(module_www, server_bodyBrotli)
 TEST(module_www, server_bodyBrotli2)
 {
     Spectacle spectacle;
-    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: br\r\n\r\n"
-                          "\x1F\x0F\x00\xF8\xA5\xB6\xBA\x52\x10\x45\x1A\x29\x17\x66\xDA\x29\x52");
+    spectacle._peer->send("GET uri HTTP/1.1\r\nContent-Encoding: br\r\nContent-Length: 17\r\n\r\n"
+                          "\x1F\x0F\x00\xF8\xA5\xB6\xBA\x52\x10\x45\x1A\x29\x17\x66\xDA\x29\x52" "extra");
     spectacle.play();
     spectacle._peer->close();
     spectacle.play();
@@ -672,16 +1763,65 @@ TEST(module_www, server_bodyBrotli3)
     LOGD("the following log lines are caused by a test, these are not errors");
 
     // extra
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: br\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: br\r\nContent-Length: 37\r\n\r\n"
                 "\x1F\x0F\x00\xF8\xA5\xB6\xBA\x52\x10\x45\x1A\x29\x17\x66\xDA\x29\x52 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad after middle
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: br\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: br\r\nContent-Length: 28\r\n\r\n"
                 "\x1F\x0F\x00\xF8\xA5\xB6\xBA\x52 abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     // bad
-    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: br\r\n\r\n"
+    PLAY_2_FAIL("GET uri HTTP/1.1\r\nContent-Encoding: br\r\nContent-Length: 19\r\n\r\n"
                 "abrakadabra shwabra", request::BadRequest, "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n");
 
     LOGD("the end of the noisy test");
 }
+
+/////////0/////////1/////////2/////////3/////////4/////////5/////////6/////////7
+TEST(module_www, server_arena)
+{
+    Spectacle spectacle;
+
+    std::size_t answered{};
+    auto roundtrip = [&](const std::string& req)
+    {
+        spectacle._peer->send(req);
+        spectacle.play();
+
+        for(; answered < spectacle._ios.size(); ++answered)
+        {
+            spectacle._ios[answered]._output->data("ok", true);
+            spectacle._ios[answered]._output->done();
+        }
+        spectacle.play();
+    };
+
+    std::string shortReq = "GET /short HTTP/1.1\r\nHost: x\r\n\r\n";
+    std::string longReq = "GET /" + std::string(6000, 'u') + " HTTP/1.1\r\nHost: x\r\n\r\n";
+
+    // taken while the head is parsed, released as the request is done
+    spectacle._peer->send(longReq.substr(0, 3000));
+    spectacle.play();
+    EXPECT_GT((*spectacle._target->stats()).arenaUsed, 0u);
+
+    roundtrip(longReq.substr(3000));
+    ASSERT_EQ(answered, 1u);
+    EXPECT_EQ((*spectacle._target->stats()).arenaUsed, 0u);
+
+    // a head bigger than the initial block regrows it
+    www::http::server::Stats stats = *spectacle._target->stats();
+    EXPECT_GE(stats.arenaHighWater, 6000u);
+    EXPECT_GT(stats.arenaCapacity, 4096u);
+
+    // warmed up, a keep-alive connection takes nothing more from the heap
+    roundtrip(longReq);
+    stats = *spectacle._target->stats();
+
+    for(std::size_t i{}; i<20; ++i)
+        roundtrip(i % 2 ? shortReq : longReq);
+
+    ASSERT_EQ(answered, 22u);
+    EXPECT_EQ((*spectacle._target->stats()).arenaAllocations, stats.arenaAllocations);
+    EXPECT_EQ((*spectacle._target->stats()).arenaCapacity, stats.arenaCapacity);
+    EXPECT_FALSE(spectacle.has<Spectacle::PeerClosed>());
+}